@@ -0,0 +1,57 @@
+ifeq ($(BASE_DIR),)
+abort:   ## This MUST be the first target :( ugly
+	@echo Make must be run from the root of the project && false
+endif
+
+CURRENT_DIR:=$(CURRENT_DIR)/bench
+
+# The library sources are compiled into the benchmark so that the wrapped
+# allocation and copy functions also see the calls made inside the library.
+BENCH_SRC:= $(BASE_DIR)/src/collection/allocator.c
+BENCH_ARRAY_SRC:= $(BASE_DIR)/src/collection/list/implementations/arraylist.c
+BENCH_TIERED_SRC:= $(BASE_DIR)/src/collection/list/implementations/tieredlist.c
+BENCH_MAP_SRC:= $(BASE_DIR)/src/collection/epoch.c \
+	$(BASE_DIR)/src/collection/map/implementations/concurrenthashmap.c
+BENCH_LOCKED_MAP_SRC:= $(BASE_DIR)/src/collection/map/implementations/hashmap.c
+BENCH_SYNC_LIST_SRC:= $(BASE_DIR)/src/collection/epoch.c \
+	$(BASE_DIR)/src/collection/list/implementations/synchronizedlist.c \
+	$(BASE_DIR)/src/collection/list/implementations/syncarraylist.c
+BENCH_CFLAGS:= -O2 -Wall -fno-builtin-memcpy -fno-builtin-memmove -I$(BASE_DIR)/include
+BENCH_WRAP:= -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free,--wrap=memcpy,--wrap=memmove
+BENCH_MAX_SIZE?= 10000000
+BENCH_MAX_THREADS?= $(shell nproc)
+BENCH_DIR:= $(if $(filter /%,$(BUILD_DIR)),$(BUILD_DIR),$(BASE_DIR)/$(BUILD_DIR))
+
+all: run
+
+listbench: listbench.c $(BENCH_SRC) $(BENCH_ARRAY_SRC)
+	gcc $(BENCH_CFLAGS) -o $(BENCH_DIR)/listbench \
+		listbench.c $(BENCH_SRC) $(BENCH_ARRAY_SRC) $(BENCH_WRAP) -lpthread
+
+tieredbench: listbench.c $(BENCH_SRC) $(BENCH_TIERED_SRC)
+	gcc $(BENCH_CFLAGS) -DBENCH_TIERED -o $(BENCH_DIR)/tieredbench \
+		listbench.c $(BENCH_SRC) $(BENCH_TIERED_SRC) $(BENCH_WRAP)
+
+mapbench: mapbench.c $(BENCH_SRC) $(BENCH_MAP_SRC)
+	gcc $(BENCH_CFLAGS) -o $(BENCH_DIR)/mapbench \
+		mapbench.c $(BENCH_SRC) $(BENCH_MAP_SRC) -lpthread
+
+lockedmapbench: mapbench.c $(BENCH_SRC) $(BENCH_LOCKED_MAP_SRC)
+	gcc $(BENCH_CFLAGS) -DBENCH_LOCKED -o $(BENCH_DIR)/lockedmapbench \
+		mapbench.c $(BENCH_SRC) $(BENCH_LOCKED_MAP_SRC) -lpthread
+
+synclistbench: synclistbench.c $(BENCH_SRC) $(BENCH_SYNC_LIST_SRC)
+	gcc $(BENCH_CFLAGS) -o $(BENCH_DIR)/synclistbench \
+		synclistbench.c $(BENCH_SRC) $(BENCH_SYNC_LIST_SRC) -lpthread
+
+lockedlistbench: synclistbench.c $(BENCH_SRC) $(BENCH_ARRAY_SRC)
+	gcc $(BENCH_CFLAGS) -DBENCH_LOCKED -o $(BENCH_DIR)/lockedlistbench \
+		synclistbench.c $(BENCH_SRC) $(BENCH_ARRAY_SRC) -lpthread
+
+run: listbench tieredbench mapbench lockedmapbench synclistbench lockedlistbench
+	$(BENCH_DIR)/listbench $(BENCH_MAX_SIZE) > $(BENCH_DIR)/listbench.json
+	$(BENCH_DIR)/tieredbench $(BENCH_MAX_SIZE) > $(BENCH_DIR)/tieredbench.json
+	$(BENCH_DIR)/mapbench $(BENCH_MAX_THREADS) > $(BENCH_DIR)/mapbench.json
+	$(BENCH_DIR)/lockedmapbench $(BENCH_MAX_THREADS) > $(BENCH_DIR)/lockedmapbench.json
+	$(BENCH_DIR)/synclistbench $(BENCH_MAX_THREADS) > $(BENCH_DIR)/synclistbench.json
+	$(BENCH_DIR)/lockedlistbench $(BENCH_MAX_THREADS) > $(BENCH_DIR)/lockedlistbench.json
@@ -0,0 +1,483 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Microbenchmarks for the list API.  Every case builds its input outside
+ * the timed region and then runs a batch of operations, repeating the
+ * batch until enough time has been measured.  Allocations and bytes
+ * copied are counted by wrapping malloc, calloc, realloc, free, memcpy and
+ * memmove at link time (see bench.mk), so they cover calls made inside the
+ * library; copies done by plain loops and realloc calls that extend in
+ * place are not counted as copied bytes.
+ *
+ * The benchmark is built once per list implementation: by default against
+ * the ArrayList, or against the TieredList when BENCH_TIERED is defined,
+ * so the same cases can be compared across implementations.
+ *
+ * Results are printed as a table on stderr and as JSON on stdout.
+ *
+ * usage: listbench [maxSize]
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+
+#ifdef BENCH_TIERED
+#define LIST_IMPLEMENTATION tiered
+#include "collection/list/implementations/tieredlist.h"
+#else
+#define LIST_IMPLEMENTATION array
+#include "collection/list/implementations/arraylist.h"
+#endif
+
+#define STRINGIFY_(x) #x
+#define STRINGIFY(x) STRINGIFY_(x)
+
+#define MAX_SIZE 10000000
+#define MIN_NANOS 20000000 // keep repeating a case until 20ms were measured
+#define MOVE_BUDGET 100000000 // element moves allowed per batch of O(n) ops
+
+
+
+// Allocation and copy accounting
+
+typedef struct {
+	uint64_t allocations;
+	uint64_t bytesCopied;
+} Counters;
+
+static bool counting = false;
+static Counters counters;
+
+void* __real_malloc(size_t);
+void* __real_calloc(size_t, size_t);
+void* __real_realloc(void*, size_t);
+void __real_free(void*);
+void* __real_memcpy(void*, const void*, size_t);
+void* __real_memmove(void*, const void*, size_t);
+
+void* __wrap_malloc(size_t size) {
+	if (counting)
+		++counters.allocations;
+	return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+	if (counting)
+		++counters.allocations;
+	return __real_calloc(n, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+	size_t oldSize = ptr == NULL ? 0 : malloc_usable_size(ptr);
+	void* result = __real_realloc(ptr, size);
+	if (counting) {
+		++counters.allocations;
+		if (result != ptr)
+			counters.bytesCopied += oldSize < size ? oldSize : size;
+	}
+	return result;
+}
+
+void __wrap_free(void* ptr) {
+	__real_free(ptr);
+}
+
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+	if (counting)
+		counters.bytesCopied += n;
+	return __real_memcpy(dest, src, n);
+}
+
+void* __wrap_memmove(void* dest, const void* src, size_t n) {
+	if (counting)
+		counters.bytesCopied += n;
+	return __real_memmove(dest, src, n);
+}
+
+
+
+// Timing
+
+typedef struct {
+	uint64_t nanos;
+	uint64_t ops;
+	Counters counters;
+} Measurement;
+
+static uint64_t startNanos;
+
+static uint64_t now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void startTimer() {
+	memset(&counters, 0, sizeof(Counters));
+	counting = true;
+	startNanos = now();
+}
+
+static void stopTimer(Measurement* m, uint64_t ops) {
+	uint64_t end = now();
+	counting = false;
+	m->nanos += end - startNanos;
+	m->ops += ops;
+	m->counters.allocations += counters.allocations;
+	m->counters.bytesCopied += counters.bytesCopied;
+}
+
+/*
+ * Number of O(n) operations to run per batch on a list of size n.
+ */
+static int64_t linearReps(int64_t n) {
+	int64_t reps = MOVE_BUDGET / (n > 0 ? n : 1);
+	if (reps > 100000)
+		reps = 100000;
+	return reps > 0 ? reps : 1;
+}
+
+static void* element(int64_t i) {
+	return (void*) (uintptr_t) (i + 1);
+}
+
+static list_List filledList(int64_t n) {
+	list_List list = list_newList();
+#ifndef BENCH_TIERED
+	list_reserve(list, n);
+#endif
+	for (int64_t i = 0; i < n; ++i)
+		list_add(list, element(i));
+	return list;
+}
+
+
+
+// Cases
+
+static void benchAdd(int64_t n, Measurement* m) {
+	list_List list = list_newList();
+	startTimer();
+	for (int64_t i = 0; i < n; ++i)
+		list_add(list, element(i));
+	stopTimer(m, n);
+	list_delList(list);
+}
+
+static void benchAddAllAt(int64_t n, Measurement* m) {
+	void* batch[16];
+	for (int i = 0; i < 16; ++i)
+		batch[i] = element(i);
+	int64_t reps = linearReps(n);
+	if (reps > n / 16 + 1)
+		reps = n / 16 + 1;
+	list_List list = filledList(n);
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		list_addAllAt(list, list_size(list) / 2, batch, 16);
+	stopTimer(m, reps);
+	list_delList(list);
+}
+
+static void benchAddAt(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	if (reps > n + 1)
+		reps = n + 1;
+	list_List list = filledList(n);
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		list_addAt(list, list_size(list) / 2, element(i));
+	stopTimer(m, reps);
+	list_delList(list);
+}
+
+static void benchRemoveAt(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	if (reps > n / 2)
+		reps = n / 2 > 0 ? n / 2 : 1;
+	list_List list = filledList(n);
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		list_removeAt(list, list_size(list) / 2);
+	stopTimer(m, reps);
+	list_delList(list);
+}
+
+static void benchRemoveAll(int64_t n, Measurement* m) {
+	// removes every other element
+	int64_t length = n / 2 > 0 ? n / 2 : 1;
+	void** arr = malloc(sizeof(void*) * length);
+	for (int64_t i = 0; i < length; ++i)
+		arr[i] = element(2 * i);
+	list_List list = filledList(n);
+	startTimer();
+	list_removeAll(list, arr, length);
+	stopTimer(m, 1);
+	list_delList(list);
+	free(arr);
+}
+
+static void benchGet(int64_t n, Measurement* m) {
+	int64_t reps = 1000000;
+	list_List list = filledList(n);
+	uint64_t index = 0;
+	uintptr_t sink = 0;
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i) {
+		// linear congruential walk over the indices
+		index = index * 6364136223846793005u + 1442695040888963407u;
+		sink += (uintptr_t) list_get(list, (int64_t) ((index >> 33) % (uint64_t) n));
+	}
+	stopTimer(m, reps);
+	if (sink == 42)
+		puts("");
+	list_delList(list);
+}
+
+static void benchIndexOf(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	list_List list = filledList(n);
+	void* last = element(n - 1);
+	int64_t sink = 0;
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		sink += list_indexOf(list, last);
+	stopTimer(m, reps);
+	if (sink == -42)
+		puts("");
+	list_delList(list);
+}
+
+static void benchToArray(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	list_List list = filledList(n);
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		free(list_toArray(list));
+	stopTimer(m, reps);
+	list_delList(list);
+}
+
+#ifndef BENCH_TIERED
+static void benchHandOff(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	list_List list = filledList(n);
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i) {
+		int64_t size, capacity;
+		void** array = list_detachArray(list, &size, &capacity);
+		list_delList(list);
+		list = list_fromArray(array, size, capacity);
+	}
+	stopTimer(m, reps);
+	list_delList(list);
+}
+
+typedef struct {
+	int64_t next;
+	int64_t end;
+} Source;
+
+static size_t readSource(void* context, void** buffer, size_t capacity) {
+	Source* source = context;
+	size_t n = 0;
+	while (n < capacity && source->next < source->end)
+		buffer[n++] = element(source->next++);
+	return n;
+}
+
+static void benchAddAllFrom(int64_t n, Measurement* m) {
+	list_List list = list_newList();
+	Source source = { 0, n };
+	startTimer();
+	list_addAllFrom(list, readSource, &source);
+	stopTimer(m, n);
+	list_delList(list);
+}
+
+static void benchAddAllFromPipelined(int64_t n, Measurement* m) {
+	list_List list = list_newList();
+	Source source = { 0, n };
+	startTimer();
+	list_addAllFromPipelined(list, readSource, &source);
+	stopTimer(m, n);
+	list_delList(list);
+}
+
+static void benchSnapshot(int64_t n, Measurement* m) {
+	int64_t reps = 1000000;
+	list_List list = filledList(n);
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		list_delList(list_snapshot(list));
+	stopTimer(m, reps);
+	list_delList(list);
+}
+#endif
+
+static bool addElement(void* element, void* context) {
+	*(uintptr_t*) context += (uintptr_t) element;
+	return true;
+}
+
+static void benchForEach(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	list_List list = filledList(n);
+	uintptr_t sink = 0;
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		list_forEach(list, addElement, &sink);
+	stopTimer(m, reps);
+	if (sink == 42)
+		puts("");
+	list_delList(list);
+}
+
+static void benchNextSpan(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	list_List list = filledList(n);
+	uintptr_t sink = 0;
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i) {
+		int64_t position = 0;
+		void* const* data;
+		size_t length;
+		while ((length = list_nextSpan(list, &position, &data)) > 0)
+			for (size_t j = 0; j < length; ++j)
+				sink += (uintptr_t) data[j];
+	}
+	stopTimer(m, reps);
+	if (sink == 42)
+		puts("");
+	list_delList(list);
+}
+
+static void benchSubList(int64_t n, Measurement* m) {
+	int64_t reps = 100000;
+	list_List list = filledList(n);
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		list_delList(list_subList(list, n / 4, n - n / 4));
+	stopTimer(m, reps);
+	list_delList(list);
+}
+
+#define VIEW_LENGTH 16
+
+static void benchViewIndexOf(int64_t n, Measurement* m) {
+	int64_t reps = 1000000;
+	list_List list = filledList(n);
+	int64_t from = n > VIEW_LENGTH ? (n - VIEW_LENGTH) / 2 : 0;
+	int64_t to = from + VIEW_LENGTH < n ? from + VIEW_LENGTH : n;
+	list_List view = list_subList(list, from, to);
+	int64_t sink = 0;
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		sink += list_indexOf(view, (void*) -1);
+	stopTimer(m, reps);
+	if (sink == -42)
+		puts("");
+	list_delList(view);
+	list_delList(list);
+}
+
+static void benchEquals(int64_t n, Measurement* m) {
+	int64_t reps = linearReps(n);
+	list_List list = filledList(n);
+	list_List other = filledList(n);
+	int64_t sink = 0;
+	startTimer();
+	for (int64_t i = 0; i < reps; ++i)
+		sink += list_equals(list, other);
+	stopTimer(m, reps);
+	if (sink == -42)
+		puts("");
+	list_delList(list);
+	list_delList(other);
+}
+
+typedef struct {
+	const char* name;
+	void (*run)(int64_t n, Measurement* m);
+} Case;
+
+static const Case cases[] = {
+	{ "add", benchAdd },
+	{ "addAt", benchAddAt },
+	{ "addAllAt", benchAddAllAt },
+	{ "removeAt", benchRemoveAt },
+	{ "get", benchGet },
+	{ "removeAll", benchRemoveAll },
+	{ "indexOf", benchIndexOf },
+	{ "toArray", benchToArray },
+#ifndef BENCH_TIERED
+	{ "handOff", benchHandOff },
+	{ "addAllFrom", benchAddAllFrom },
+	{ "pipelined", benchAddAllFromPipelined },
+	{ "snapshot", benchSnapshot },
+#endif
+	{ "forEach", benchForEach },
+	{ "nextSpan", benchNextSpan },
+	{ "subList", benchSubList },
+	{ "viewSearch", benchViewIndexOf },
+	{ "equals", benchEquals },
+};
+
+
+
+int main(int argc, char* argv[]) {
+	int64_t maxSize = argc > 1 ? atoll(argv[1]) : MAX_SIZE;
+	bool first = true;
+	printf("{\n  \"implementation\": \"%s\",\n  \"results\": [",
+			STRINGIFY(LIST_IMPLEMENTATION));
+	fprintf(stderr, "%-10s %10s %14s %14s %16s\n",
+			"case", "size", "ns/op", "allocs/op", "bytesCopied/op");
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+		for (int64_t n = 10; n <= maxSize; n *= 10) {
+			Measurement m = { 0 };
+			while (m.nanos < MIN_NANOS)
+				cases[c].run(n, &m);
+			double ops = (double) m.ops;
+			double nsPerOp = m.nanos / ops;
+			double allocsPerOp = m.counters.allocations / ops;
+			double bytesPerOp = m.counters.bytesCopied / ops;
+			fprintf(stderr, "%-10s %10lld %14.1f %14.3f %16.1f\n", cases[c].name,
+					(long long) n, nsPerOp, allocsPerOp, bytesPerOp);
+			printf("%s\n    {\"case\": \"%s\", \"size\": %lld, \"ops\": %llu, "
+					"\"nsPerOp\": %.3f, \"allocsPerOp\": %.6f, \"bytesCopiedPerOp\": %.3f}",
+					first ? "" : ",", cases[c].name, (long long) n,
+					(unsigned long long) m.ops, nsPerOp, allocsPerOp, bytesPerOp);
+			first = false;
+		}
+	printf("\n  ]\n}\n");
+	return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Multi-threaded throughput benchmark for maps.  Every case fills a map
+ * with KEY_COUNT keys, then runs a number of threads for a fixed time, each
+ * doing a random mix of get (reads) and put or remove (writes, half each,
+ * so the size of the map stays about the same) on random keys.  Cases
+ * cover several read/write mixes and thread counts up to maxThreads.
+ *
+ * The benchmark is built once per map: by default against the
+ * ConcurrentHashMap, or against the single-threaded HashMap behind one
+ * global mutex when BENCH_LOCKED is defined, as a baseline.
+ *
+ * Results are printed as a table on stderr and as JSON on stdout.
+ *
+ * usage: mapbench [maxThreads]
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifdef BENCH_LOCKED
+#define MAP_IMPLEMENTATION hash
+#include "collection/map/implementations/hashmap.h"
+#else
+#define MAP_IMPLEMENTATION concurrent
+#include "collection/map/implementations/concurrenthashmap.h"
+#endif
+
+#define STRINGIFY_(x) #x
+#define STRINGIFY(x) STRINGIFY_(x)
+
+#define KEY_COUNT (1 << 20)
+#define RUN_NANOS 200000000 // each case runs for 200ms
+#define CHECK_EVERY 256 // operations between looks at the stop flag
+
+
+
+// Map access
+
+#ifdef BENCH_LOCKED
+static pthread_mutex_t mapLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void* get(map_Map map, void* key) {
+#ifdef BENCH_LOCKED
+	pthread_mutex_lock(&mapLock);
+	void* result = map_get(map, key);
+	pthread_mutex_unlock(&mapLock);
+	return result;
+#else
+	return map_get(map, key);
+#endif
+}
+
+static void put(map_Map map, void* key) {
+#ifdef BENCH_LOCKED
+	pthread_mutex_lock(&mapLock);
+	map_put(map, key, key);
+	pthread_mutex_unlock(&mapLock);
+#else
+	map_put(map, key, key);
+#endif
+}
+
+static void remove_(map_Map map, void* key) {
+#ifdef BENCH_LOCKED
+	pthread_mutex_lock(&mapLock);
+	map_remove(map, key);
+	pthread_mutex_unlock(&mapLock);
+#else
+	map_remove(map, key);
+#endif
+}
+
+
+
+// Workers
+
+typedef struct {
+	map_Map map;
+	int readPercent;
+	uint64_t seed;
+	uint64_t ops;
+	pthread_t thread;
+} Worker;
+
+static atomic_bool stop;
+
+static uint64_t nextRandom(uint64_t* state) {
+	// xorshift64*
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * UINT64_C(2685821657736338717);
+}
+
+static void* key(uint64_t r) {
+	return (void*) (uintptr_t) ((r >> 16) % KEY_COUNT + 1);
+}
+
+static void* runWorker(void* arg) {
+	Worker* worker = arg;
+	uint64_t state = worker->seed;
+	uint64_t ops = 0;
+	uintptr_t sink = 0;
+	while (!atomic_load_explicit(&stop, memory_order_relaxed)) {
+		for (int i = 0; i < CHECK_EVERY; ++i) {
+			uint64_t r = nextRandom(&state);
+			int dice = r % 100;
+			if (dice < worker->readPercent)
+				sink += (uintptr_t) get(worker->map, key(r));
+			else if (dice & 1)
+				put(worker->map, key(r));
+			else
+				remove_(worker->map, key(r));
+		}
+		ops += CHECK_EVERY;
+	}
+	worker->ops = ops;
+	return (void*) sink;
+}
+
+static uint64_t now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*
+ * Runs one case and returns the throughput in operations per second.
+ */
+static double runCase(int threads, int readPercent) {
+	map_Map map = map_newMap();
+	for (uint64_t i = 1; i <= KEY_COUNT; ++i)
+		map_put(map, (void*) (uintptr_t) i, (void*) (uintptr_t) i);
+	Worker* workers = calloc(threads, sizeof(Worker));
+	atomic_store(&stop, false);
+	uint64_t start = now();
+	for (int t = 0; t < threads; ++t) {
+		workers[t].map = map;
+		workers[t].readPercent = readPercent;
+		workers[t].seed = 0x9e3779b97f4a7c15u * (t + 1);
+		pthread_create(&workers[t].thread, NULL, runWorker, &workers[t]);
+	}
+	struct timespec pause = { 0, RUN_NANOS };
+	nanosleep(&pause, NULL);
+	atomic_store(&stop, true);
+	uint64_t ops = 0;
+	for (int t = 0; t < threads; ++t) {
+		pthread_join(workers[t].thread, NULL);
+		ops += workers[t].ops;
+	}
+	uint64_t nanos = now() - start;
+	free(workers);
+	map_delMap(map);
+	return ops * 1e9 / nanos;
+}
+
+static const int readPercents[] = { 100, 90, 50 };
+
+
+
+int main(int argc, char* argv[]) {
+	int maxThreads = argc > 1 ? atoi(argv[1]) : (int) sysconf(_SC_NPROCESSORS_ONLN);
+	bool first = true;
+	printf("{\n  \"implementation\": \"%s\",\n  \"results\": [",
+			STRINGIFY(MAP_IMPLEMENTATION));
+	fprintf(stderr, "%-8s %8s %14s\n", "reads%", "threads", "Mops/s");
+	for (size_t c = 0; c < sizeof(readPercents) / sizeof(readPercents[0]); ++c)
+		for (int threads = 1;; threads = threads * 2 > maxThreads ? maxThreads : threads * 2) {
+			double opsPerSecond = runCase(threads, readPercents[c]);
+			fprintf(stderr, "%-8d %8d %14.2f\n", readPercents[c], threads, opsPerSecond / 1e6);
+			printf("%s\n    {\"readPercent\": %d, \"threads\": %d, \"opsPerSecond\": %.0f}",
+					first ? "" : ",", readPercents[c], threads, opsPerSecond);
+			first = false;
+			if (threads >= maxThreads)
+				break;
+		}
+	printf("\n  ]\n}\n");
+	return 0;
+}
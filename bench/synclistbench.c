@@ -0,0 +1,201 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Multi-threaded throughput benchmark for lists read by many threads.
+ * Every case fills a list with ELEMENT_COUNT elements, then runs a number
+ * of threads for a fixed time, each doing a random mix of get (reads) and
+ * set (writes, so the size of the list stays the same) at random indexes.
+ * Cases cover several read/write mixes, mostly reads, and thread counts up
+ * to maxThreads.
+ *
+ * The benchmark is built once per list: by default against the
+ * SynchronizedList, or against the single-threaded ArrayList behind one
+ * global mutex when BENCH_LOCKED is defined, as a baseline.
+ *
+ * Results are printed as a table on stderr and as JSON on stdout.
+ *
+ * usage: synclistbench [maxThreads]
+ */
+
+#define _GNU_SOURCE
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifdef BENCH_LOCKED
+#define LIST_IMPLEMENTATION array
+#include "collection/list/implementations/arraylist.h"
+#else
+#define LIST_IMPLEMENTATION synchronized
+#include "collection/list/implementations/synchronizedlist.h"
+#endif
+
+#define STRINGIFY_(x) #x
+#define STRINGIFY(x) STRINGIFY_(x)
+
+#define ELEMENT_COUNT (1 << 16)
+#define RUN_NANOS 200000000 // each case runs for 200ms
+#define CHECK_EVERY 256 // operations between looks at the stop flag
+
+
+
+// List access
+
+#ifdef BENCH_LOCKED
+static pthread_mutex_t listLock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void* get(list_List list, int64_t index) {
+#ifdef BENCH_LOCKED
+	pthread_mutex_lock(&listLock);
+	void* result = list_get(list, index);
+	pthread_mutex_unlock(&listLock);
+	return result;
+#else
+	return list_get(list, index);
+#endif
+}
+
+static void set(list_List list, int64_t index, void* element) {
+#ifdef BENCH_LOCKED
+	pthread_mutex_lock(&listLock);
+	list_set(list, index, element);
+	pthread_mutex_unlock(&listLock);
+#else
+	list_set(list, index, element);
+#endif
+}
+
+
+
+// Workers
+
+typedef struct {
+	list_List list;
+	int readPercent;
+	uint64_t seed;
+	uint64_t ops;
+	pthread_t thread;
+} Worker;
+
+static atomic_bool stop;
+
+static uint64_t nextRandom(uint64_t* state) {
+	// xorshift64*
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * UINT64_C(2685821657736338717);
+}
+
+static int64_t position(uint64_t r) {
+	return (r >> 16) % ELEMENT_COUNT;
+}
+
+static void* runWorker(void* arg) {
+	Worker* worker = arg;
+	uint64_t state = worker->seed;
+	uint64_t ops = 0;
+	uintptr_t sink = 0;
+	while (!atomic_load_explicit(&stop, memory_order_relaxed)) {
+		for (int i = 0; i < CHECK_EVERY; ++i) {
+			uint64_t r = nextRandom(&state);
+			if ((int) (r % 100) < worker->readPercent)
+				sink += (uintptr_t) get(worker->list, position(r));
+			else
+				set(worker->list, position(r), (void*) (uintptr_t) r);
+		}
+		ops += CHECK_EVERY;
+	}
+	worker->ops = ops;
+	return (void*) sink;
+}
+
+static uint64_t now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/*
+ * Runs one case and returns the throughput in operations per second.
+ */
+static double runCase(int threads, int readPercent) {
+	list_List list = list_newList();
+	for (uint64_t i = 1; i <= ELEMENT_COUNT; ++i)
+		list_add(list, (void*) (uintptr_t) i);
+	Worker* workers = calloc(threads, sizeof(Worker));
+	atomic_store(&stop, false);
+	uint64_t start = now();
+	for (int t = 0; t < threads; ++t) {
+		workers[t].list = list;
+		workers[t].readPercent = readPercent;
+		workers[t].seed = 0x9e3779b97f4a7c15u * (t + 1);
+		pthread_create(&workers[t].thread, NULL, runWorker, &workers[t]);
+	}
+	struct timespec pause = { 0, RUN_NANOS };
+	nanosleep(&pause, NULL);
+	atomic_store(&stop, true);
+	uint64_t ops = 0;
+	for (int t = 0; t < threads; ++t) {
+		pthread_join(workers[t].thread, NULL);
+		ops += workers[t].ops;
+	}
+	uint64_t nanos = now() - start;
+	free(workers);
+	list_delList(list);
+	return ops * 1e9 / nanos;
+}
+
+static const int readPercents[] = { 100, 99, 90 };
+
+
+
+int main(int argc, char* argv[]) {
+	int maxThreads = argc > 1 ? atoi(argv[1]) : (int) sysconf(_SC_NPROCESSORS_ONLN);
+	bool first = true;
+	printf("{\n  \"implementation\": \"%s\",\n  \"results\": [",
+			STRINGIFY(LIST_IMPLEMENTATION));
+	fprintf(stderr, "%-8s %8s %14s\n", "reads%", "threads", "Mops/s");
+	for (size_t c = 0; c < sizeof(readPercents) / sizeof(readPercents[0]); ++c)
+		for (int threads = 1;; threads = threads * 2 > maxThreads ? maxThreads : threads * 2) {
+			double opsPerSecond = runCase(threads, readPercents[c]);
+			fprintf(stderr, "%-8d %8d %14.2f\n", readPercents[c], threads, opsPerSecond / 1e6);
+			printf("%s\n    {\"readPercent\": %d, \"threads\": %d, \"opsPerSecond\": %.0f}",
+					first ? "" : ",", readPercents[c], threads, opsPerSecond);
+			first = false;
+			if (threads >= maxThreads)
+				break;
+		}
+	printf("\n  ]\n}\n");
+	return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stddef.h>
+
+#ifndef COLLECTION_ALLOCATOR_H
+#define COLLECTION_ALLOCATOR_H
+
+/**
+ * Memory interface used by collections for every allocation they make.
+ * Each callback receives <tt>context</tt> as its first argument.  Sizes
+ * are passed back on reallocation and deallocation so that allocators
+ * which do not track block sizes themselves (arenas, pools) can serve
+ * collections directly.  An allocator must outlive every collection
+ * created with it.
+ */
+typedef struct collection_Allocator {
+	void* (*allocate)(void* context, size_t size);
+	void* (*reallocate)(void* context, void* ptr, size_t oldSize, size_t newSize);
+	void (*deallocate)(void* context, void* ptr, size_t size);
+	void* context;
+} collection_Allocator;
+
+/**
+ * Allocator backed by <tt>malloc</tt>, <tt>realloc</tt> and
+ * <tt>free</tt>.  Used by every collection that is not given one.
+ */
+extern const collection_Allocator collection_stdAllocator;
+
+
+
+// Arena
+
+typedef struct collection_Arena collection_Arena;
+
+/**
+ * Creates a bump allocator that carves allocations out of blocks of
+ * <tt>blockSize</tt> bytes.  Individual deallocations are no-ops unless
+ * they release the most recent allocation still held, so that memory
+ * released in the reverse order of its allocation is reused; all memory
+ * is handed back at once by {@link #resetArena} or {@link #delArena}.
+ *
+ * @param blockSize size of each block requested from <tt>malloc</tt>
+ * @return the new arena
+ */
+collection_Arena* collection_newArena(size_t blockSize);
+
+/**
+ * Releases every allocation made from the arena and all of its blocks.
+ * Collections created with the arena must not be used afterwards.
+ */
+void collection_delArena(collection_Arena*);
+
+/**
+ * Releases every allocation made from the arena while keeping its first
+ * block for reuse.
+ */
+void collection_resetArena(collection_Arena*);
+
+/**
+ * Returns the allocator interface of the arena.
+ *
+ * @return an allocator valid until the arena is deleted
+ */
+const collection_Allocator* collection_arenaAllocator(collection_Arena*);
+
+
+
+// Pool
+
+typedef struct collection_Pool collection_Pool;
+
+/**
+ * Creates a pool of fixed size slots.  Requests of at most
+ * <tt>slotSize</tt> bytes are served from a free list refilled
+ * <tt>slotsPerBlock</tt> slots at a time; larger requests fall through
+ * to <tt>malloc</tt>.
+ *
+ * @param slotSize size in bytes of each slot
+ * @param slotsPerBlock number of slots requested from <tt>malloc</tt> at a time
+ * @return the new pool
+ */
+collection_Pool* collection_newPool(size_t slotSize, size_t slotsPerBlock);
+
+/**
+ * Releases the pool and all of its blocks.  Collections created with the
+ * pool must not be used afterwards.
+ */
+void collection_delPool(collection_Pool*);
+
+/**
+ * Returns the allocator interface of the pool.
+ *
+ * @return an allocator valid until the pool is deleted
+ */
+const collection_Allocator* collection_poolAllocator(collection_Pool*);
+
+#endif
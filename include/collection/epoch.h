@@ -0,0 +1,95 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stddef.h>
+
+#include "collection/allocator.h"
+
+#ifndef COLLECTION_EPOCH_H
+#define COLLECTION_EPOCH_H
+
+/**
+ * Epoch-based memory reclamation for collections whose readers do not
+ * lock.  A reader brackets every access to shared memory with
+ * {@link #epochEnter} and {@link #epochExit}; a writer that unlinks a
+ * block hands it to {@link #epochRetire} instead of deallocating it, and
+ * the block is deallocated once every reader that might still see it has
+ * left its critical section.
+ *
+ * Each thread that uses a domain gets a record the first time it enters
+ * or retires, which stays with the domain until the domain is deleted.
+ * Critical sections may nest.  A reader that stays inside a critical
+ * section holds back the reclamation of everything retired meanwhile, and
+ * blocks retired by a thread that exits are only deallocated when another
+ * thread takes over its record or the domain is deleted.
+ */
+typedef struct collection_EpochDomain collection_EpochDomain;
+
+/**
+ * Creates a reclamation domain.  Retired blocks are returned to
+ * <tt>allocator</tt>, which must be thread safe.
+ *
+ * @param allocator allocator the retired blocks came from
+ * @return the new domain
+ */
+collection_EpochDomain* collection_newEpochDomain(const collection_Allocator* allocator);
+
+/**
+ * Deallocates every block still retired in the domain and the domain
+ * itself.  No thread may be inside a critical section of the domain.
+ */
+void collection_delEpochDomain(collection_EpochDomain*);
+
+/**
+ * Enters a critical section: blocks retired from now on are not
+ * deallocated until the calling thread leaves it.
+ */
+void collection_epochEnter(collection_EpochDomain*);
+
+/**
+ * Leaves the critical section entered by the matching
+ * {@link #epochEnter}.
+ */
+void collection_epochExit(collection_EpochDomain*);
+
+/**
+ * Deallocates <tt>ptr</tt> once no reader can hold a reference to it.  The
+ * block must already be unreachable for readers that enter from now on.
+ * Every so often, and whenever the blocks this thread holds have grown by
+ * 64 KiB, the call also tries to advance the epoch and deallocates the
+ * blocks this thread retired earlier that have become safe.
+ *
+ * @param ptr block to deallocate
+ * @param size size of the block, passed on to the allocator
+ */
+void collection_epochRetire(collection_EpochDomain*, void* ptr, size_t size);
+
+/**
+ * Tries to advance the epoch and deallocates the blocks retired by the
+ * calling thread that have become safe to deallocate.
+ */
+void collection_epochCollect(collection_EpochDomain*);
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/list/list.h"
+
+#ifndef ARRAYDEQUE_H
+#define ARRAYDEQUE_H
+
+/*
+ * ArrayDeque specific operations.  The list interface itself is declared
+ * in list.h; the deque implements all of it, with insertion and removal
+ * at either end in constant time.
+ */
+#define list_addFirst LIST_NAME(addFirst)
+#define list_addLast LIST_NAME(addLast)
+#define list_pollFirst LIST_NAME(pollFirst)
+#define list_pollLast LIST_NAME(pollLast)
+#define list_peekFirst LIST_NAME(peekFirst)
+#define list_peekLast LIST_NAME(peekLast)
+#define list_removeRange LIST_NAME(removeRange)
+
+
+
+// Deque Operations
+
+/**
+ * Inserts the specified element at the front of this deque.
+ *
+ * @param e the element to add
+ */
+void list_addFirst(list_List, void* e);
+
+/**
+ * Inserts the specified element at the end of this deque.  This method
+ * is equivalent to {@link #add}.
+ *
+ * @param e the element to add
+ */
+void list_addLast(list_List, void* e);
+
+/**
+ * Retrieves and removes the first element of this deque, or returns
+ * <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the head of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_pollFirst(list_List);
+
+/**
+ * Retrieves and removes the last element of this deque, or returns
+ * <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the tail of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_pollLast(list_List);
+
+/**
+ * Retrieves, but does not remove, the first element of this deque, or
+ * returns <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the head of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_peekFirst(list_List);
+
+/**
+ * Retrieves, but does not remove, the last element of this deque, or
+ * returns <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the tail of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_peekLast(list_List);
+
+
+
+// Positional Access Operations
+
+/**
+ * Removes from this deque all of the elements whose index is between
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  The
+ * elements on the shorter side of the removed range are the ones moved.
+ *
+ * @param fromIndex index of first element to be removed
+ * @param toIndex index after last element to be removed
+ * @throws IndexOutOfBoundsException if <tt>fromIndex</tt> or
+ * <tt>toIndex</tt> is out of range
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size() || toIndex &lt; fromIndex</tt>)
+ */
+void list_removeRange(list_List, int64_t fromIndex, int64_t toIndex);
+
+#endif
@@ -27,410 +27,558 @@
 #include <stdint.h>
 #include <stddef.h>
 
-#ifndef LIST_IMPLEMENTATION
-#error "LIST_IMPLEMENTATION is not defined and is required for list.h"
-#else
+#include "collection/allocator.h"
+#include "collection/list/list.h"
 
-#ifndef LIST_H
-#define LIST_H
+#ifndef ARRAYLIST_H
+#define ARRAYLIST_H
 
-#define list_ LIST_IMPLEMENTATION##_list_
+/*
+ * ArrayList specific operations.  The list interface itself is declared
+ * in list.h.
+ */
+#define list_newSmallList LIST_NAME(newSmallList)
+#define list_newSmallListWithAllocator LIST_NAME(newSmallListWithAllocator)
+#define list_fromArray LIST_NAME(fromArray)
+#define list_fromArrayWithAllocator LIST_NAME(fromArrayWithAllocator)
+#define list_setGrowthPolicy LIST_NAME(setGrowthPolicy)
+#define list_capacity LIST_NAME(capacity)
+#define list_reserve LIST_NAME(reserve)
+#define list_shrinkToFit LIST_NAME(shrinkToFit)
+#define list_detachArray LIST_NAME(detachArray)
+#define list_removeRange LIST_NAME(removeRange)
+#define list_insertGap LIST_NAME(insertGap)
+#define list_Reader LIST_NAME(Reader)
+#define list_addAllFrom LIST_NAME(addAllFrom)
+#define list_addAllFromPipelined LIST_NAME(addAllFromPipelined)
+#define list_Comparator LIST_NAME(Comparator)
+#define list_sort LIST_NAME(sort)
+#define list_parallelSort LIST_NAME(parallelSort)
+#define list_assumeSorted LIST_NAME(assumeSorted)
+#define list_comparator LIST_NAME(comparator)
+#define list_binarySearch LIST_NAME(binarySearch)
+#define list_lowerBound LIST_NAME(lowerBound)
+#define list_upperBound LIST_NAME(upperBound)
+#define list_insertSorted LIST_NAME(insertSorted)
+#define list_snapshot LIST_NAME(snapshot)
+#define list_Stats LIST_NAME(Stats)
+#define list_getStats LIST_NAME(getStats)
+#define list_tagSite LIST_NAME(tagSite)
+#define list_dumpStats LIST_NAME(dumpStats)
+#define list_SearchKernel LIST_NAME(SearchKernel)
+#define list_SearchKernels LIST_NAME(SearchKernels)
+#define list_searchKernels LIST_NAME(searchKernels)
 
-typedef void* list_List;
+/**
+ * Constructs an empty list that keeps its first few elements inside the
+ * list header, so a list that never outgrows them costs a single
+ * allocation.  The number of inline slots is fixed when the library is
+ * built by <tt>LIST_INLINE_CAPACITY</tt> (4 by default).  The list moves
+ * its elements to the heap on overflow and back on
+ * {@link #shrinkToFit} once they fit again; every other operation
+ * behaves exactly as on a list made by {@link #newList}.
+ *
+ * @return the new list
+ */
+list_List list_newSmallList();
 
-list_List list_newList();
+/**
+ * Constructs an empty small list, as by {@link #newSmallList}, whose
+ * memory is obtained from <tt>allocator</tt>.
+ *
+ * @param allocator allocator that must outlive the list
+ * @return the new list
+ */
+list_List list_newSmallListWithAllocator(const collection_Allocator* allocator);
+
+/**
+ * Constructs a list that takes ownership of <tt>array</tt> instead of
+ * copying it.  The first <tt>size</tt> slots of the array become the
+ * elements of the list, and the list may fill the remaining slots up to
+ * <tt>capacity</tt> before it has to reallocate.  The array must have been
+ * obtained from <tt>malloc</tt> or <tt>realloc</tt>; the list frees it
+ * when it is deleted.  The caller must not use the array afterwards.
+ *
+ * @param array heap array of at least <tt>capacity</tt> slots, or
+ * <tt>NULL</tt> if <tt>capacity</tt> is 0
+ * @param size number of elements in the array
+ * @param capacity number of slots in the array, at least <tt>size</tt>
+ * @return the new list
+ */
+list_List list_fromArray(void** array, int64_t size, int64_t capacity);
 
-bool list_delList(list_List);
+/**
+ * Constructs a list that takes ownership of <tt>array</tt>, as by
+ * {@link #fromArray}, where the array was obtained from
+ * <tt>allocator</tt> with room for <tt>capacity</tt> elements.
+ *
+ * @param allocator allocator that must outlive the list
+ * @param array array of at least <tt>capacity</tt> slots, or <tt>NULL</tt>
+ * if <tt>capacity</tt> is 0
+ * @param size number of elements in the array
+ * @param capacity number of slots in the array, at least <tt>size</tt>
+ * @return the new list
+ */
+list_List list_fromArrayWithAllocator(const collection_Allocator* allocator,
+		void** array, int64_t size, int64_t capacity);
 
 
 
-// Query Operations
+// Capacity Operations
 
 /**
- * Returns the number of elements in this list.  If this list contains
- * more than <tt>Integer.MAX_VALUE</tt> elements, returns
- * <tt>Integer.MAX_VALUE</tt>.
+ * Sets the policy used to grow the backing array when it runs out of
+ * room.  The new capacity is <tt>capacity * factor + increment</tt>, or
+ * the required size if that is larger.  A factor of <tt>1.0</tt> with a
+ * non-zero increment gives linear growth (the historic behavior used a
+ * fixed increment of 10); a factor above <tt>1.0</tt> gives geometric
+ * growth and amortized constant-time appends.  The policy of a view is
+ * that of the list owning the array.
  *
- * @return the number of elements in this list
+ * @param factor multiplier applied to the current capacity, at least 1.0
+ * @param increment number of slots added after scaling, at least 0
  */
-int64_t list_size(list_List);
+void list_setGrowthPolicy(list_List, double factor, int64_t increment);
 
 /**
- * Returns <tt>true</tt> if this list contains no elements.
+ * Returns the number of elements this list can hold before its backing
+ * array has to be reallocated.  For a view, the elements of the rest of
+ * the list it is a view of are taken into account.
  *
- * @return <tt>true</tt> if this list contains no elements
+ * @return the capacity of this list
  */
-bool list_isEmpty(list_List);
+int64_t list_capacity(list_List);
 
 /**
- * Returns <tt>true</tt> if this list contains the specified element.
- * More formally, returns <tt>true</tt> if and only if this list contains
- * at least one element <tt>e</tt> such that
- * <tt>(o==null&nbsp;?&nbsp;e==null&nbsp;:&nbsp;o.equals(e))</tt>.
+ * Increases the capacity of this list, if necessary, so that it can hold
+ * at least the number of elements specified by the minimum capacity
+ * argument without reallocating.
  *
- * @param o element whose presence in this list is to be tested
- * @return <tt>true</tt> if this list contains the specified element
- * @throws ClassCastException if the type of the specified element
- * is incompatible with this list (optional)
- * @throws NullPoint64_terException if the specified element is null and this
- * list does not permit null elements (optional)
+ * @param minCapacity the desired minimum capacity
  */
-bool list_contains(list_List, void* o);
+void list_reserve(list_List, int64_t minCapacity);
 
 /**
- * Returns an array containing all of the elements in this list in proper
- * sequence (from first to last element).
- *
- * <p>The returned array will be "safe" in that no references to it are
- * maint64_tained by this list.  (In other words, this method must
- * allocate a new array even if this list is backed by an array).
- * The caller is thus free to modify the returned array.
- *
- * <p>This method acts as bridge between array-based and collection-based
- * APIs.
+ * Trims the capacity of this list to be the list's current size.  An
+ * application can use this operation to hand back the slack left over
+ * after a bulk load.  On a view, trims the list owning the array.
+ */
+void list_shrinkToFit(list_List);
+
+/**
+ * Hands the backing array of this list over to the caller and leaves the
+ * list empty, with no backing array.  The elements are not copied unless
+ * they are kept inside the list header (see {@link #newSmallList}) or
+ * the list is a view of another list, in which case they are copied into
+ * a new array of exactly <tt>size</tt> slots and the view is cleared, or
+ * the array is shared with a snapshot (see {@link #snapshot}), in which
+ * case the list first takes a private copy.
+ * The array is owned by the caller from then on and must be released
+ * with the list's allocator (<tt>free</tt> for lists that were not given
+ * one), or passed to {@link #fromArray} to make it a list again.
  *
- * @return an array containing all of the elements in this list in proper
- * sequence
+ * @param size receives the number of elements in the returned array
+ * @param capacity receives the number of slots in the returned array, if
+ * not <tt>NULL</tt>
+ * @return the former backing array of this list, or <tt>NULL</tt> if it
+ * had none
  */
-void** list_toArray(list_List);
+void** list_detachArray(list_List, int64_t* size, int64_t* capacity);
 
 
 
-// Modification Operations
+// Positional Access Operations
 
 /**
- * Appends the specified element to the end of this list (optional
- * operation).
+ * Removes from this list all of the elements whose index is between
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  Shifts
+ * any succeeding elements to the left (reduces their index) with a single
+ * block move.  If <tt>toIndex==fromIndex</tt>, this operation has no
+ * effect.
  *
- * <p>Lists that support this operation may place limitations on what
- * elements may be added to this list.  In particular, some
- * lists will refuse to add null elements, and others will impose
- * restrictions on the type of elements that may be added.  List
- * classes should clearly specify in their documentation any restrictions
- * on what elements may be added.
- *
- * @param e element to be appended to this list
- * @return <tt>true</tt> (as specified by {@link Collection#add})
- * @throws UnsupportedOperationException if the <tt>add</tt> operation
- * is not supported by this list
- * @throws ClassCastException if the class of the specified element
- * prevents it from being added to this list
- * @throws NullPoint64_terException if the specified element is null and this
- * list does not permit null elements
- * @throws IllegalArgumentException if some property of this element
- * prevents it from being added to this list
+ * @param fromIndex index of first element to be removed
+ * @param toIndex index after last element to be removed
+ * @throws IndexOutOfBoundsException if <tt>fromIndex</tt> or
+ * <tt>toIndex</tt> is out of range
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size() || toIndex &lt; fromIndex</tt>)
  */
-bool list_add(list_List, void* e);
+void list_removeRange(list_List, int64_t fromIndex, int64_t toIndex);
 
 /**
- * Removes the first occurrence of the specified element from this list,
- * if it is present (optional operation).  If this list does not contain
- * the element, it is unchanged.  More formally, removes the element with
- * the lowest index <tt>i</tt> such that
- * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>
- * (if such an element exists).  Returns <tt>true</tt> if this list
- * contained the specified element (or equivalently, if this list changed
- * as a result of the call).
+ * Inserts <tt>n</tt> null elements at the specified position in this
+ * list.  Shifts the element currently at that position (if any) and any
+ * subsequent elements to the right (adds <tt>n</tt> to their indices)
+ * with a single block move.  The new slots can then be filled with
+ * {@link #set(int64_t, void*)}.
  *
- * @param o element to be removed from this list, if present
- * @return <tt>true</tt> if this list contained the specified element
- * @throws ClassCastException if the type of the specified element
- * is incompatible with this list (optional)
- * @throws NullPoint64_terException if the specified element is null and this
- * list does not permit null elements (optional)
- * @throws UnsupportedOperationException if the <tt>remove</tt> operation
- * is not supported by this list
+ * @param index index at which the first null element is to be inserted
+ * @param n number of elements to insert
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
  */
-bool list_remove(list_List, void* o);
+void list_insertGap(list_List, int64_t index, int64_t n);
 
 
 
-// Bulk Modification Operations
+// Streaming Operations
 
 /**
- * Returns <tt>true</tt> if this list contains all of the elements of the
- * specified collection.
+ * Produces elements for {@link #addAllFrom}.  The reader stores up to
+ * <tt>capacity</tt> elements in <tt>buffer</tt>, which is never empty,
+ * and returns how many it stored; returning 0 ends the input.
  *
- * @param  c collection to be checked for containment in this list
- * @return <tt>true</tt> if this list contains all of the elements of the
- * specified collection
- * @throws ClassCastException if the types of one or more elements
- * in the specified collection are incompatible with this
- * list (optional)
- * @throws NullPoint64_terException if the specified collection contains one
- * or more null elements and this list does not permit null
- * elements (optional), or if the specified collection is null
- * @see #contains(void*)
- */
-bool list_containsAll(list_List, void* arr[], size_t arrLength);
-
-/**
- * Appends all of the elements in the specified collection to the end of
- * this list, in the order that they are returned by the specified
- * collection's iterator (optional operation).  The behavior of this
- * operation is undefined if the specified collection is modified while
- * the operation is in progress.  (Note that this will occur if the
- * specified collection is this list, and it's nonempty.)
- *
- * @param c collection containing elements to be added to this list
- * @return <tt>true</tt> if this list changed as a result of the call
- * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
- * is not supported by this list
- * @throws ClassCastException if the class of an element of the specified
- * collection prevents it from being added to this list
- * @throws NullPoint64_terException if the specified collection contains one
- * or more null elements and this list does not permit null
- * elements, or if the specified collection is null
- * @throws IllegalArgumentException if some property of an element of the
- * specified collection prevents it from being added to this list
- * @see #add(void*)
- */
-bool list_addAll(list_List, void* arr[], size_t arrLength);
-
-/**
- * Inserts all of the elements in the specified collection int64_to this
- * list at the specified position (optional operation).  Shifts the
- * element currently at that position (if any) and any subsequent
- * elements to the right (increases their indices).  The new elements
- * will appear in this list in the order that they are returned by the
- * specified collection's iterator.  The behavior of this operation is
- * undefined if the specified collection is modified while the
- * operation is in progress.  (Note that this will occur if the specified
- * collection is this list, and it's nonempty.)
- *
- * @param index index at which to insert the first element from the
- *  specified collection
- * @param c collection containing elements to be added to this list
- * @return <tt>true</tt> if this list changed as a result of the call
- * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
- * is not supported by this list
- * @throws ClassCastException if the class of an element of the specified
- * collection prevents it from being added to this list
- * @throws NullPoint64_terException if the specified collection contains one
- * or more null elements and this list does not permit null
- * elements, or if the specified collection is null
- * @throws IllegalArgumentException if some property of an element of the
- * specified collection prevents it from being added to this list
- * @throws IndexOutOfBoundsException if the index is out of range
- * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ * @param context the context given to {@link #addAllFrom}
+ * @param buffer where to store the elements
+ * @param capacity number of slots available in <tt>buffer</tt>
+ * @return number of elements stored, 0 at the end of the input
  */
-bool list_addAllAt(list_List, int64_t index, void* arr[], size_t arrLength);
+typedef size_t (*list_Reader)(void* context, void** buffer, size_t capacity);
 
 /**
- * Removes from this list all of its elements that are contained in the
- * specified collection (optional operation).
+ * Appends every element produced by <tt>reader</tt> to the end of this
+ * list, in order, until it returns 0.  The reader writes straight into the
+ * spare capacity at the end of the backing array, which grows by the
+ * list's growth policy whenever less than a chunk is left, so input of
+ * unknown length is never staged in a temporary array.
  *
- * @param c collection containing elements to be removed from this list
- * @return <tt>true</tt> if this list changed as a result of the call
- * @throws UnsupportedOperationException if the <tt>removeAll</tt> operation
- * is not supported by this list
- * @throws ClassCastException if the class of an element of this list
- * is incompatible with the specified collection (optional)
- * @throws NullPoint64_terException if this list contains a null element and the
- * specified collection does not permit null elements (optional),
- * or if the specified collection is null
- * @see #remove(void*)
- * @see #contains(void*)
+ * @param reader the source of the elements
+ * @param context passed to every call of <tt>reader</tt>
+ * @return number of elements appended
  */
-bool list_removeAll(list_List, void* arr[], size_t arrLength);
+int64_t list_addAllFrom(list_List, list_Reader reader, void* context);
 
 /**
- * Retains only the elements in this list that are contained in the
- * specified collection (optional operation).  In other words, removes
- * from this list all of its elements that are not contained in the
- * specified collection.
+ * Appends every element produced by <tt>reader</tt>, as
+ * {@link #addAllFrom} does, while a helper thread calls the reader.  The
+ * helper fills one of two fixed size chunk buffers while this thread
+ * appends the other, so a slow reader, such as one reading a socket or a
+ * file, overlaps with the growth of the list.  The memory used beyond the
+ * list itself is the two chunks, whatever the length of the input.  The
+ * reader is called from the helper thread only, one call at a time.
  *
- * @param c collection containing elements to be retained in this list
- * @return <tt>true</tt> if this list changed as a result of the call
- * @throws UnsupportedOperationException if the <tt>retainAll</tt> operation
- * is not supported by this list
- * @throws ClassCastException if the class of an element of this list
- * is incompatible with the specified collection (optional)
- * @throws NullPoint64_terException if this list contains a null element and the
- * specified collection does not permit null elements (optional),
- * or if the specified collection is null
- * @see #remove(void*)
- * @see #contains(void*)
+ * @param reader the source of the elements
+ * @param context passed to every call of <tt>reader</tt>
+ * @return number of elements appended
  */
-bool list_retainAll(list_List, void* arr[], size_t arrLength);
+int64_t list_addAllFromPipelined(list_List, list_Reader reader, void* context);
+
+
+
+// Sorting Operations
 
 /**
- * Removes all of the elements from this list (optional operation).
- * The list will be empty after this call returns.
+ * Compares two elements of a list.  Unlike the comparator of
+ * <tt>qsort</tt>, it receives the elements themselves rather than
+ * pointers to them.
  *
- * @throws UnsupportedOperationException if the <tt>clear</tt> operation
- * is not supported by this list
+ * @return a negative integer, zero, or a positive integer as <tt>a</tt>
+ * is less than, equal to, or greater than <tt>b</tt>
  */
-void list_clear(list_List);
-
+typedef int (*list_Comparator)(const void* a, const void* b);
 
-
-// Comparison and hashing
+/**
+ * Sorts this list in place according to the order induced by the
+ * specified comparator.  The sort is stable: equal elements keep their
+ * relative order.  Runs already in ascending or strictly descending order
+ * are detected and merged rather than re-sorted, so nearly sorted input
+ * is sorted in close to linear time.  The scratch space used is at most
+ * half the size of the list.  Afterwards the list is sorted by <tt>c</tt>,
+ * as after {@link #assumeSorted}.  Sorting is a structural modification:
+ * other views of the list it belongs to become stale.
+ *
+ * @param c the comparator used to compare list elements
+ */
+void list_sort(list_List, list_Comparator c);
 
 /**
- * Compares the specified object with this list for equality.  Returns
- * <tt>true</tt> if and only if the specified object is also a list, both
- * lists have the same size, and all corresponding pairs of elements in
- * the two lists are <i>equal</i>.  (Two elements <tt>e1</tt> and
- * <tt>e2</tt> are <i>equal</i> if <tt>(e1==null ? e2==null :
- * e1.equals(e2))</tt>.)  In other words, two lists are defined to be
- * equal if they contain the same elements in the same order.  This
- * definition ensures that the equals method works properly across
- * different implementations of the <tt>List</tt> int64_terface.
+ * Sorts this list as {@link #sort} does, splitting the work across up to
+ * <tt>threads</tt> threads: each sorts one slice of the list, then the
+ * slices are merged pairwise, every merge itself split between the
+ * threads.  The comparator is called concurrently from several threads.
+ * Lists too small to benefit, or a single thread, fall back to
+ * {@link #sort}.  The scratch space used is the size of the list.
  *
- * @param o the object to be compared for equality with this list
- * @return <tt>true</tt> if the specified object is equal to this list
+ * @param c the comparator used to compare list elements
+ * @param threads maximum number of threads to sort with, at least 1
  */
-bool list_equals(list_List, list_List o);
+void list_parallelSort(list_List, list_Comparator c, int threads);
 
 
 
-// Positional Access Operations
+// Sorted List Operations
 
 /**
- * Returns the element at the specified position in this list.
+ * Records that this list is sorted according to <tt>c</tt>.  While it
+ * is, {@link #contains}, {@link #indexOf}, {@link #lastIndexOf} and
+ * {@link #remove} only scan the elements that compare equal to their
+ * argument, found by binary search, so <tt>c</tt> is also called with
+ * their arguments.  Operations that keep the order ({@link #insertSorted},
+ * removals, and {@link #add} of an element not less than the last one)
+ * keep the list sorted; any other insertion or {@link #set} forgets the
+ * comparator, for this list and for the lists it is a view of; a
+ * {@link #set} also makes every other view of the same list forget it.
+ * The result of the sorted operations is undefined if the list is not
+ * actually sorted by <tt>c</tt>.
  *
- * @param index index of the element to return
- * @return the element at the specified position in this list
- * @throws IndexOutOfBoundsException if the index is out of range
- * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ * @param c the comparator the list is sorted by
  */
-void* list_get(list_List, int64_t index);
+void list_assumeSorted(list_List, list_Comparator c);
 
 /**
- * Replaces the element at the specified position in this list with the
- * specified element (optional operation).
+ * Returns the comparator this list is known to be sorted by, or
+ * <tt>NULL</tt> if it is not known to be sorted.
  *
- * @param index index of the element to replace
- * @param element element to be stored at the specified position
- * @return the element previously at the specified position
- * @throws UnsupportedOperationException if the <tt>set</tt> operation
- * is not supported by this list
- * @throws ClassCastException if the class of the specified element
- * prevents it from being added to this list
- * @throws NullPoint64_terException if the specified element is null and
- * this list does not permit null elements
- * @throws IllegalArgumentException if some property of the specified
- * element prevents it from being added to this list
- * @throws IndexOutOfBoundsException if the index is out of range
- * (<tt>index &lt; 0 || index &gt;= size()</tt>)
- */
-void* list_set(list_List, int64_t index, void* element);
-
-/**
- * Inserts the specified element at the specified position in this list
- * (optional operation).  Shifts the element currently at that position
- * (if any) and any subsequent elements to the right (adds one to their
- * indices).
- *
- * @param index index at which the specified element is to be inserted
- * @param element element to be inserted
- * @throws UnsupportedOperationException if the <tt>add</tt> operation
- * is not supported by this list
- * @throws ClassCastException if the class of the specified element
- * prevents it from being added to this list
- * @throws NullPoint64_terException if the specified element is null and
- * this list does not permit null elements
- * @throws IllegalArgumentException if some property of the specified
- * element prevents it from being added to this list
- * @throws IndexOutOfBoundsException if the index is out of range
- * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ * @return the comparator of this sorted list, or <tt>NULL</tt>
  */
-void list_addAt(list_List, int64_t index, void* element);
+list_Comparator list_comparator(list_List);
 
 /**
- * Removes the element at the specified position in this list (optional
- * operation).  Shifts any subsequent elements to the left (subtracts one
- * from their indices).  Returns the element that was removed from the
- * list.
+ * Searches this sorted list for an element equal to <tt>key</tt>
+ * according to the list's comparator.  If several elements are equal to
+ * the key, the index of the first is returned.
  *
- * @param index the index of the element to be removed
- * @return the element previously at the specified position
- * @throws UnsupportedOperationException if the <tt>remove</tt> operation
- * is not supported by this list
- * @throws IndexOutOfBoundsException if the index is out of range
- * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ * @param key the key to search for
+ * @return the index of the first element equal to <tt>key</tt>, if any;
+ * otherwise <tt>(-(insertion point) - 1)</tt>, where the insertion point
+ * is the index of the first element greater than the key, or the size of
+ * the list if there is none
  */
-void* list_removeAt(list_List, int64_t index);
-
+int64_t list_binarySearch(list_List, void* key);
 
+/**
+ * Returns the index of the first element of this sorted list that is not
+ * less than <tt>key</tt>, or the size of the list if there is none.
+ *
+ * @param key the key to search for
+ * @return the lower bound of <tt>key</tt>
+ */
+int64_t list_lowerBound(list_List, void* key);
 
-// Search Operations
+/**
+ * Returns the index of the first element of this sorted list that is
+ * greater than <tt>key</tt>, or the size of the list if there is none.
+ * The elements equal to the key are those from its lower bound up to its
+ * upper bound.
+ *
+ * @param key the key to search for
+ * @return the upper bound of <tt>key</tt>
+ */
+int64_t list_upperBound(list_List, void* key);
 
 /**
- * Returns the index of the first occurrence of the specified element
- * in this list, or -1 if this list does not contain the element.
- * More formally, returns the lowest index <tt>i</tt> such that
- * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
- * or -1 if there is no such index.
+ * Inserts the specified element into this sorted list after every element
+ * not greater than it, with one binary search and one block move, and
+ * keeps the list sorted.
  *
- * @param o element to search for
- * @return the index of the first occurrence of the specified element in
- * this list, or -1 if this list does not contain the element
- * @throws ClassCastException if the type of the specified element
- * is incompatible with this list (optional)
- * @throws NullPoint64_terException if the specified element is null and this
- * list does not permit null elements (optional)
+ * @param e element to be inserted
+ * @return the index at which the element was inserted
  */
-int64_t list_indexOf(list_List, void* o);
+int64_t list_insertSorted(list_List, void* e);
+
+
+
+// Snapshot Operations
 
 /**
- * Returns the index of the last occurrence of the specified element
- * in this list, or -1 if this list does not contain the element.
- * More formally, returns the highest index <tt>i</tt> such that
- * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
- * or -1 if there is no such index.
+ * Returns an immutable snapshot of this list: a list holding the elements
+ * this list holds now, which later changes to this list do not affect.
+ * The snapshot shares the backing array through a reference count, so
+ * taking and deleting it costs O(1) and copies nothing; the first
+ * modification of this list while a snapshot is alive gives the list a
+ * private copy of the array.  Modifying the snapshot, or a view of it, is
+ * an error.  Snapshots of views and of lists that keep their elements
+ * inside the header (see {@link #newSmallList}) are copies.
+ *
+ * <p>A snapshot may be read, snapshotted again and deleted from any thread
+ * while this list is being modified.  Taking a snapshot of this list
+ * itself reads it and must not race with its modification.  Modifying a
+ * view of this list while a snapshot shares its array gives this list its
+ * private copy, as modifying this list does.
  *
- * @param o element to search for
- * @return the index of the last occurrence of the specified element in
- * this list, or -1 if this list does not contain the element
- * @throws ClassCastException if the type of the specified element
- * is incompatible with this list (optional)
- * @throws NullPoint64_terException if the specified element is null and this
- * list does not permit null elements (optional)
+ * @return an immutable snapshot of this list
  */
-int64_t list_lastIndexOf(list_List, void* o);
+list_List list_snapshot(list_List);
+
 
 
+// Statistics
+
+/**
+ * Operations counted separately by the statistics of a list.
+ */
+enum {
+	LIST_STATS_ADD, // add
+	LIST_STATS_INSERT, // addAt, addAllAt, insertGap, insertSorted
+	LIST_STATS_ADD_ALL, // addAll, addAllFrom, addAllFromPipelined
+	LIST_STATS_REMOVE, // remove, removeAt, removeRange
+	LIST_STATS_REMOVE_ALL, // removeAll, retainAll, clear
+	LIST_STATS_GET, // get
+	LIST_STATS_SET, // set
+	LIST_STATS_SEARCH, // contains, containsAll, indexOf, lastIndexOf, binary searches
+	LIST_STATS_SORT, // sort, parallelSort
+	LIST_STATS_OPERATIONS
+};
 
-// View
+/**
+ * Counters kept by a list when the library is built with
+ * <tt>-DCOLLECTION_STATS</tt>.  Elements shifted counts the elements moved
+ * within the backing array by insertions and removals; comparisons counts
+ * the calls of comparators and the elements examined by searches.
+ */
+typedef struct {
+	uint64_t calls[LIST_STATS_OPERATIONS];
+	uint64_t reallocs;
+	uint64_t elementsShifted;
+	uint64_t comparisons;
+	int64_t peakSize;
+	int64_t slack;
+	const char* file; // creation site, NULL if not tagged
+	int line;
+} list_Stats;
 
 /**
- * Returns a view of the portion of this list between the specified
- * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  (If
- * <tt>fromIndex</tt> and <tt>toIndex</tt> are equal, the returned list is
- * empty.)  The returned list is backed by this list, so non-structural
- * changes in the returned list are reflected in this list, and vice-versa.
- * The returned list supports all of the optional list operations supported
- * by this list.<p>
+ * Copies the counters of this list to <tt>stats</tt>.  The slack is the
+ * number of unused slots in the backing array at the time of the call,
+ * always 0 for a snapshot, whose array belongs to the list it was taken
+ * from.
  *
- * This method eliminates the need for explicit range operations (of
- * the sort that commonly exist for arrays).  Any operation that expects
- * a list can be used as a range operation by passing a subList view
- * instead of a whole list.  For example, the following idiom
- * removes a range of elements from a list:
+ * @param stats receives the counters
+ * @return <tt>true</tt>, or <tt>false</tt> without touching
+ * <tt>stats</tt> if the library was built without
+ * <tt>-DCOLLECTION_STATS</tt>
+ */
+bool list_getStats(list_List, list_Stats* stats);
+
+/**
+ * Records <tt>file</tt> and <tt>line</tt> as the place this list was
+ * created, under which {@link #dumpStats} reports it.  Usually called
+ * through <tt>LIST_SITE</tt>, which tags a list with the place it is
+ * used and compiles to nothing without <tt>-DCOLLECTION_STATS</tt>:
  * <pre>
- *  list.subList(from, to).clear();
+ *   list_List list = LIST_SITE(list_newList());
  * </pre>
- * Similar idioms may be constructed for <tt>indexOf</tt> and
- * <tt>lastIndexOf</tt>, and all of the algorithms in the
- * <tt>Collections</tt> class can be applied to a subList.<p>
+ * Lists that are not tagged are reported together, and views and
+ * snapshots inherit the site of their list.  Does nothing if the library
+ * was built without <tt>-DCOLLECTION_STATS</tt>.
  *
- * The semantics of the list returned by this method become undefined if
- * the backing list (i.e., this list) is <i>structurally modified</i> in
- * any way other than via the returned list.  (Structural modifications are
- * those that change the size of this list, or otherwise perturb it in such
- * a fashion that iterations in progress may yield incorrect results.)
+ * @param file name of the source file, which must outlive the list
+ * @param line line in the source file
+ * @return this list
+ */
+list_List list_tagSite(list_List, const char* file, int line);
+
+/**
+ * Writes one line to <tt>fd</tt> with the counters summed over every list
+ * ever created, then one line per creation site (see {@link #tagSite})
+ * with the counters of its lists, live and deleted, the site that shifted
+ * the most elements first.  The counters of lists being modified by other
+ * threads meanwhile are read without synchronization and may be slightly
+ * out of date.  Writes a single note if the library was built without
+ * <tt>-DCOLLECTION_STATS</tt>.
+ *
+ * @param fd file descriptor to write to
+ */
+void list_dumpStats(int fd);
+
+#ifdef COLLECTION_STATS
+#define LIST_SITE(list) list_tagSite((list), __FILE__, __LINE__)
+#else
+#define LIST_SITE(list) (list)
+#endif
+
+
+
+
+// Test Hooks
+
+/**
+ * A pointer search kernel: returns the index of the first (or last) slot
+ * of <tt>array[0, size)</tt> equal to <tt>o</tt>, or -1.
+ */
+typedef int64_t (*list_SearchKernel)(void** array, int64_t size, void* o);
+
+/**
+ * The forward and backward search kernels built for one instruction set.
+ */
+typedef struct {
+	const char* name;
+	list_SearchKernel indexOf;
+	list_SearchKernel lastIndexOf;
+} list_SearchKernels;
+
+#ifdef COLLECTION_TEST
+/**
+ * Returns the pointer search kernels this CPU supports, the scalar one
+ * first and the one used by the list last, so that tests can check every
+ * kernel and not only the one picked at load time.  Only built with
+ * <tt>-DCOLLECTION_TEST</tt>.
  *
- * @param fromIndex low endpoint64_t (inclusive) of the subList
- * @param toIndex high endpoint64_t (exclusive) of the subList
- * @return a view of the specified range within this list
- * @throws IndexOutOfBoundsException for an illegal endpoint64_t index value
- * (<tt>fromIndex &lt; 0 || toIndex &gt; size ||
- * fromIndex &gt; toIndex</tt>)
+ * @param count receives the number of kernels returned
+ * @return the kernels
  */
-list_List list_subList(list_List, int64_t fromIndex, int64_t toIndex);
+const list_SearchKernels* list_searchKernels(size_t* count);
+#endif
+
 
+
+
+// Inline Accessors
+
+/*
+ * Defining ARRAYLIST_INLINE before including this header turns list_size,
+ * list_isEmpty, list_get and list_set into static inline functions that
+ * read the list header directly (see arraylistlayout.h), so hot loops do
+ * not call into the library.  list_get and list_set still call the
+ * library for views, whose array may have moved, and list_set for sorted
+ * lists and lists that share their array with a snapshot.  The size of a
+ * stale view is not checked.
+ * Calls made inline are not counted by COLLECTION_STATS.  A program built
+ * this way refuses to link or load against a library whose layout
+ * version differs.
+ */
+#ifdef ARRAYLIST_INLINE
+#include <assert.h>
+#include "collection/list/implementations/arraylistlayout.h"
+
+__attribute__((used)) static const int* const array_list_layoutCheck =
+		&ARRAYLIST_LAYOUT_SYMBOL(ARRAYLIST_LAYOUT_VERSION);
+
+static inline int64_t array_list_inlineSize(list_List list) {
+	return ((const array_list_Layout*) list)->size;
+}
+
+static inline bool array_list_inlineIsEmpty(list_List list) {
+	return ((const array_list_Layout*) list)->size == 0;
+}
+
+static inline void* array_list_inlineGet(list_List list, int64_t index) {
+	const array_list_Layout* arrList = list;
+	if (arrList->superList != NULL)
+		return LIST_NAME_OF(array, get)(list, index);
+	assert(index >= 0 && index < arrList->size);
+	return arrList->array[index];
+}
+
+static inline void* array_list_inlineSet(list_List list, int64_t index, void* element) {
+	array_list_Layout* arrList = list;
+	if (arrList->superList != NULL || arrList->comparator != NULL
+			|| arrList->shareCount != NULL || arrList->readOnly)
+		return LIST_NAME_OF(array, set)(list, index, element);
+	assert(index >= 0 && index < arrList->size);
+	void* result = arrList->array[index];
+	arrList->array[index] = element;
+	++arrList->orderCount;
+	return result;
+}
+
+#undef list_size
+#undef list_isEmpty
+#undef list_get
+#undef list_set
+#define list_size array_list_inlineSize
+#define list_isEmpty array_list_inlineIsEmpty
+#define list_get array_list_inlineGet
+#define list_set array_list_inlineSet
 #endif
 
 #endif
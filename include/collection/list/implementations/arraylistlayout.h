@@ -0,0 +1,84 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/list/implementations/arraylist.h"
+
+#ifndef ARRAYLISTLAYOUT_H
+#define ARRAYLISTLAYOUT_H
+
+/*
+ * Layout of an ArrayList header, shared by arraylist.c and the inline
+ * accessors of arraylist.h.  The fields the accessors read come first, so
+ * their offsets do not depend on build flags such as COLLECTION_STATS;
+ * changing any of them, or what they mean, must bump
+ * ARRAYLIST_LAYOUT_VERSION.
+ *
+ * The library defines a symbol named after the version it was built with.
+ * Code compiled with the inline accessors references the symbol of the
+ * version in its header, so linking or loading it against a library of
+ * another version fails with an undefined symbol instead of misreading
+ * lists.
+ */
+#define ARRAYLIST_LAYOUT_VERSION 3
+
+#define ARRAYLIST_LAYOUT_SYMBOL_(version) array_list_layoutVersion##version
+#define ARRAYLIST_LAYOUT_SYMBOL(version) ARRAYLIST_LAYOUT_SYMBOL_(version)
+
+extern const int ARRAYLIST_LAYOUT_SYMBOL(ARRAYLIST_LAYOUT_VERSION);
+
+typedef struct array_list_Layout {
+	// read by the inline accessors
+	void** array; // for a view, into the root's array as of its last call
+	int64_t size;
+	list_List superList;
+	list_Comparator comparator; // set while the list is known to be sorted by it
+	_Atomic int64_t* shareCount; // lists sharing the array, NULL if not shared
+	bool readOnly; // set on snapshots and their views
+	uint64_t orderCount; // sets and sorts of the root, as last seen by a view
+
+	// private to arraylist.c
+	int64_t maxSize; // root only
+	int64_t offset; // index of the first element of a view in the root
+	struct array_list_Layout* root; // the list owning the array, itself if not a view
+	uint64_t modCount; // structural changes of the root, as last seen by a view
+	double growthFactor;
+	int64_t growthIncrement;
+	const collection_Allocator* allocator;
+#ifdef COLLECTION_STATS
+	list_Stats stats;
+	struct array_list_Site* site;
+	struct array_list_Layout* previousAtSite;
+	struct array_list_Layout* nextAtSite;
+#endif
+	bool hasInlineStorage;
+	void* inlineArray[]; // LIST_INLINE_CAPACITY slots when hasInlineStorage
+} array_list_Layout;
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/list/list.h"
+
+#ifndef CONCURRENTLIST_H
+#define CONCURRENTLIST_H
+
+/*
+ * ConcurrentList: an append-only list that any number of threads may add
+ * to and read from at the same time without external locking.  The list
+ * interface is declared in list.h.
+ *
+ * Producers reserve slots with an atomic fetch-add.  Elements live in
+ * segments of doubling size that are published once and never moved, so
+ * the address of an element stays valid for the life of the list.  The
+ * size seen by readers only covers elements whose writes are complete;
+ * <tt>get</tt>, <tt>set</tt>, <tt>size</tt> and <tt>isEmpty</tt> are
+ * wait-free, and <tt>add</tt> and <tt>addAll</tt> are lock-free as long
+ * as the allocator is thread safe (the standard allocator is; arenas and
+ * pools are not).
+ *
+ * Queries such as <tt>indexOf</tt>, <tt>toArray</tt> and
+ * <tt>equals</tt> see the elements published when they start;
+ * <tt>forEach</tt> and <tt>nextSpan</tt> also see elements published
+ * while they run.  Spans are read with plain loads, so they must not be
+ * read while another thread calls <tt>set</tt> on their elements.
+ * <tt>clear</tt> and <tt>delList</tt> must not run concurrently with any
+ * other operation.  Operations that remove elements or insert them
+ * anywhere but at the end (<tt>remove</tt>, <tt>removeAll</tt>,
+ * <tt>retainAll</tt>, <tt>addAllAt</tt>, <tt>addAt</tt>,
+ * <tt>removeAt</tt>) and <tt>subList</tt> are not supported; calling
+ * them aborts the program, also in builds with NDEBUG.
+ */
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/list/list.h"
+
+#ifndef SYNCHRONIZEDLIST_H
+#define SYNCHRONIZEDLIST_H
+
+/*
+ * SynchronizedList: an ArrayList that any number of threads may read while
+ * other threads modify it, for lists that are read far more often than
+ * they are written.  The list interface is declared in list.h.
+ *
+ * Writers take a mutex, so modifications run one at a time.  Readers take
+ * no lock and write no shared memory: <tt>size</tt>, <tt>isEmpty</tt>,
+ * <tt>get</tt>, <tt>contains</tt>, <tt>indexOf</tt>,
+ * <tt>lastIndexOf</tt>, <tt>toArray</tt> and <tt>equals</tt> read the
+ * list optimistically and retry if a writer ran meanwhile, so their
+ * throughput grows with the number of reading threads as long as writes
+ * are rare.  Backing arrays replaced or freed by a writer are reclaimed
+ * once no reader can still be reading them.
+ *
+ * <tt>forEach</tt> iterates over the elements the list held when it
+ * started, and its action may modify the list.  <tt>containsAll</tt>
+ * takes the writer mutex.  <tt>delList</tt> must not run concurrently with
+ * any other operation.  <tt>nextSpan</tt> and <tt>subList</tt> are not
+ * supported and abort.  The allocator given to the list must be thread
+ * safe.
+ */
+
+#endif
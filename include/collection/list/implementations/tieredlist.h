@@ -0,0 +1,78 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/list/list.h"
+
+#ifndef TIEREDLIST_H
+#define TIEREDLIST_H
+
+/*
+ * TieredList specific operations.  The list interface itself is declared
+ * in list.h; the tiered list implements all of it.  Elements live in
+ * fixed-size circular blocks indexed by a top-level array, so
+ * <tt>get</tt> and <tt>set</tt> stay constant time while inserting or
+ * removing at an arbitrary position costs O(sqrt(n)) instead of O(n).
+ */
+#define list_blockSize LIST_NAME(blockSize)
+#define list_removeRange LIST_NAME(removeRange)
+
+
+
+// Capacity Operations
+
+/**
+ * Returns the number of elements held by each block of this list.  The
+ * block size is a power of two kept close to the square root of the size
+ * of the list; it is doubled or halved, rebuilding the blocks, as the
+ * list grows or shrinks.
+ *
+ * @return the block size of this list
+ */
+int64_t list_blockSize(list_List);
+
+
+
+// Positional Access Operations
+
+/**
+ * Removes from this list all of the elements whose index is between
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  Shifts
+ * any succeeding elements to the left (reduces their index).  If
+ * <tt>toIndex==fromIndex</tt>, this operation has no effect.
+ *
+ * @param fromIndex index of first element to be removed
+ * @param toIndex index after last element to be removed
+ * @throws IndexOutOfBoundsException if <tt>fromIndex</tt> or
+ * <tt>toIndex</tt> is out of range
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size() || toIndex &lt; fromIndex</tt>)
+ */
+void list_removeRange(list_List, int64_t fromIndex, int64_t toIndex);
+
+#endif
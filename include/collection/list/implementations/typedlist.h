@@ -0,0 +1,385 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+
+#include "collection/allocator.h"
+#include "collection/recordfile.h"
+#include "collection/list/listname.h"
+
+#ifndef TYPEDLIST_H
+#define TYPEDLIST_H
+
+/*
+ * Typed array lists store their elements by value in one contiguous
+ * array instead of as void* slots.  A family is instantiated for an
+ * implementation name and an element type:
+ *
+ *   LIST_DECLARE_TYPED(point, struct Point)              // in a header
+ *   LIST_DEFINE_TYPED(point, struct Point, LIST_EQUALS_BYTES)  // in one .c
+ *
+ * which produces point_list_List, point_list_add(point_list_List,
+ * struct Point) and so on, following the same <implementation>_list_
+ * naming as every other list.  The functions behave like their ArrayList
+ * counterparts with elements compared by the equals macro given to
+ * LIST_DEFINE_TYPED.  Lists of int64_t (int64), double (double) and
+ * uint32_t (uint32) are instantiated by the library.
+ *
+ * Beyond the ArrayList operations a typed list offers list_data, which
+ * returns its backing array for direct reads and writes until the next
+ * structural modification.
+ *
+ * A typed list can be saved with list_writeFile as a record file (see
+ * recordfile.h) holding its elements back to back, and list_mapFile makes
+ * a read-only list of such a file by mapping it into memory, in constant
+ * time whatever its size.  Every query of a mapped list reads the mapping
+ * directly and pages are loaded the first time they are touched.
+ * Modifying a mapped list, or writing through its list_data, is an error.
+ * The file records the element type as spelled in LIST_DEFINE_TYPED, and
+ * list_mapFile returns NULL for a file written by a list of another type.
+ */
+
+#define LIST_TYPED_INIT_MAX_SIZE 10
+
+// equality for scalar element types
+#define LIST_EQUALS_VALUE(a, b) ((a) == (b))
+// equality for structs without padding
+#define LIST_EQUALS_BYTES(a, b) (memcmp(&(a), &(b), sizeof(a)) == 0)
+
+#define LIST_DECLARE_TYPED(impl, T) \
+	typedef void* LIST_NAME_OF(impl, List); \
+	LIST_NAME_OF(impl, List) LIST_NAME_OF(impl, newList)(); \
+	LIST_NAME_OF(impl, List) LIST_NAME_OF(impl, newListWithAllocator)(const collection_Allocator* allocator); \
+	LIST_NAME_OF(impl, List) LIST_NAME_OF(impl, mapFile)(const char* path); \
+	bool LIST_NAME_OF(impl, writeFile)(LIST_NAME_OF(impl, List), const char* path); \
+	bool LIST_NAME_OF(impl, delList)(LIST_NAME_OF(impl, List)); \
+	void LIST_NAME_OF(impl, setGrowthPolicy)(LIST_NAME_OF(impl, List), double factor, int64_t increment); \
+	int64_t LIST_NAME_OF(impl, capacity)(LIST_NAME_OF(impl, List)); \
+	void LIST_NAME_OF(impl, reserve)(LIST_NAME_OF(impl, List), int64_t minCapacity); \
+	void LIST_NAME_OF(impl, shrinkToFit)(LIST_NAME_OF(impl, List)); \
+	int64_t LIST_NAME_OF(impl, size)(LIST_NAME_OF(impl, List)); \
+	bool LIST_NAME_OF(impl, isEmpty)(LIST_NAME_OF(impl, List)); \
+	bool LIST_NAME_OF(impl, contains)(LIST_NAME_OF(impl, List), T o); \
+	T* LIST_NAME_OF(impl, toArray)(LIST_NAME_OF(impl, List)); \
+	T* LIST_NAME_OF(impl, data)(LIST_NAME_OF(impl, List)); \
+	bool LIST_NAME_OF(impl, add)(LIST_NAME_OF(impl, List), T e); \
+	bool LIST_NAME_OF(impl, remove)(LIST_NAME_OF(impl, List), T o); \
+	bool LIST_NAME_OF(impl, addAll)(LIST_NAME_OF(impl, List), const T arr[], size_t arrLength); \
+	bool LIST_NAME_OF(impl, addAllAt)(LIST_NAME_OF(impl, List), int64_t index, const T arr[], size_t arrLength); \
+	void LIST_NAME_OF(impl, clear)(LIST_NAME_OF(impl, List)); \
+	bool LIST_NAME_OF(impl, equals)(LIST_NAME_OF(impl, List), LIST_NAME_OF(impl, List) o); \
+	T LIST_NAME_OF(impl, get)(LIST_NAME_OF(impl, List), int64_t index); \
+	T LIST_NAME_OF(impl, set)(LIST_NAME_OF(impl, List), int64_t index, T element); \
+	void LIST_NAME_OF(impl, addAt)(LIST_NAME_OF(impl, List), int64_t index, T element); \
+	T LIST_NAME_OF(impl, removeAt)(LIST_NAME_OF(impl, List), int64_t index); \
+	void LIST_NAME_OF(impl, removeRange)(LIST_NAME_OF(impl, List), int64_t fromIndex, int64_t toIndex); \
+	int64_t LIST_NAME_OF(impl, indexOf)(LIST_NAME_OF(impl, List), T o); \
+	int64_t LIST_NAME_OF(impl, lastIndexOf)(LIST_NAME_OF(impl, List), T o);
+
+/*
+ * The searches test blocks of 8 elements without an early exit so the
+ * compiler can vectorize the comparisons, then locate the match inside
+ * the block that contains it.
+ */
+#define LIST_DEFINE_TYPED(impl, T, isEqual) \
+	typedef struct { \
+		T* array; \
+		int64_t size; \
+		int64_t maxSize; \
+		double growthFactor; \
+		int64_t growthIncrement; \
+		const collection_Allocator* allocator; \
+		collection_RecordFile file; /* mapping is NULL unless the list maps a file */ \
+	} LIST_NAME_OF(impl, Impl); \
+	\
+	LIST_NAME_OF(impl, List) LIST_NAME_OF(impl, newList)() { \
+		return LIST_NAME_OF(impl, newListWithAllocator)(&collection_stdAllocator); \
+	} \
+	\
+	LIST_NAME_OF(impl, List) LIST_NAME_OF(impl, newListWithAllocator)(const collection_Allocator* allocator) { \
+		LIST_NAME_OF(impl, Impl)* result = NULL; \
+		result = allocator->allocate(allocator->context, sizeof(LIST_NAME_OF(impl, Impl))); \
+		assert(result != NULL); \
+		result->array = allocator->allocate(allocator->context, sizeof(T) * LIST_TYPED_INIT_MAX_SIZE); \
+		assert(result->array != NULL); \
+		result->size = 0; \
+		result->maxSize = LIST_TYPED_INIT_MAX_SIZE; \
+		result->growthFactor = 1.5; \
+		result->growthIncrement = 0; \
+		result->allocator = allocator; \
+		memset(&result->file, 0, sizeof(result->file)); \
+		return (LIST_NAME_OF(impl, List)) result; \
+	} \
+	\
+	LIST_NAME_OF(impl, List) LIST_NAME_OF(impl, mapFile)(const char* path) { \
+		const collection_Allocator* allocator = &collection_stdAllocator; \
+		collection_RecordFile file; \
+		if (!collection_mapRecordFile(&file, path, #T, sizeof(T))) \
+			return NULL; \
+		LIST_NAME_OF(impl, Impl)* result = NULL; \
+		result = allocator->allocate(allocator->context, sizeof(LIST_NAME_OF(impl, Impl))); \
+		assert(result != NULL); \
+		result->array = (T*) file.records; \
+		result->size = file.count; \
+		result->maxSize = file.count; \
+		result->growthFactor = 1.5; \
+		result->growthIncrement = 0; \
+		result->allocator = allocator; \
+		result->file = file; \
+		return (LIST_NAME_OF(impl, List)) result; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, writeFile)(LIST_NAME_OF(impl, List) list, const char* path) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		return collection_writeRecordFile(path, #T, typedList->array, sizeof(T), \
+				typedList->size); \
+	} \
+	\
+	bool LIST_NAME_OF(impl, delList)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		const collection_Allocator* allocator = typedList->allocator; \
+		if (typedList->file.mapping != NULL) \
+			collection_unmapRecordFile(&typedList->file); \
+		else \
+			allocator->deallocate(allocator->context, typedList->array, sizeof(T) * typedList->maxSize); \
+		allocator->deallocate(allocator->context, typedList, sizeof(LIST_NAME_OF(impl, Impl))); \
+		return true; \
+	} \
+	\
+	static void LIST_NAME_OF(impl, resizeArray)(LIST_NAME_OF(impl, Impl)* typedList, int64_t newMaxSize) { \
+		const collection_Allocator* allocator = typedList->allocator; \
+		assert(typedList->file.mapping == NULL); \
+		T* temp = allocator->reallocate(allocator->context, typedList->array, \
+				sizeof(T) * typedList->maxSize, sizeof(T) * newMaxSize); \
+		assert(temp != NULL || newMaxSize == 0); \
+		typedList->array = temp; \
+		typedList->maxSize = newMaxSize; \
+	} \
+	\
+	static void LIST_NAME_OF(impl, bulkUpdateSize)(LIST_NAME_OF(impl, Impl)* typedList, int64_t minSize) { \
+		if (minSize <= typedList->maxSize) \
+			return; \
+		int64_t newMaxSize = (int64_t) (typedList->maxSize * typedList->growthFactor) \
+				+ typedList->growthIncrement; \
+		if (newMaxSize < minSize) \
+			newMaxSize = minSize; \
+		LIST_NAME_OF(impl, resizeArray)(typedList, newMaxSize); \
+	} \
+	\
+	void LIST_NAME_OF(impl, setGrowthPolicy)(LIST_NAME_OF(impl, List) list, double factor, int64_t increment) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(factor >= 1.0 && increment >= 0); \
+		assert(factor > 1.0 || increment > 0); \
+		typedList->growthFactor = factor; \
+		typedList->growthIncrement = increment; \
+	} \
+	\
+	int64_t LIST_NAME_OF(impl, capacity)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		return typedList->maxSize; \
+	} \
+	\
+	void LIST_NAME_OF(impl, reserve)(LIST_NAME_OF(impl, List) list, int64_t minCapacity) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(minCapacity >= 0); \
+		if (minCapacity > typedList->maxSize) \
+			LIST_NAME_OF(impl, resizeArray)(typedList, minCapacity); \
+	} \
+	\
+	void LIST_NAME_OF(impl, shrinkToFit)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		if (typedList->size == typedList->maxSize) \
+			return; \
+		if (typedList->size == 0) { \
+			const collection_Allocator* allocator = typedList->allocator; \
+			assert(typedList->file.mapping == NULL); \
+			allocator->deallocate(allocator->context, typedList->array, sizeof(T) * typedList->maxSize); \
+			typedList->array = NULL; \
+			typedList->maxSize = 0; \
+		} else \
+			LIST_NAME_OF(impl, resizeArray)(typedList, typedList->size); \
+	} \
+	\
+	int64_t LIST_NAME_OF(impl, size)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		return typedList->size; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, isEmpty)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		return typedList->size == 0; \
+	} \
+	\
+	int64_t LIST_NAME_OF(impl, indexOf)(LIST_NAME_OF(impl, List) list, T o) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		const T* array = typedList->array; \
+		int64_t i = 0; \
+		for (; i + 8 <= typedList->size; i += 8) { \
+			bool found = false; \
+			for (int k = 0; k < 8; ++k) \
+				found |= isEqual(array[i + k], o); \
+			if (found) \
+				break; \
+		} \
+		for (; i < typedList->size; ++i) \
+			if (isEqual(array[i], o)) \
+				return i; \
+		return -1; \
+	} \
+	\
+	int64_t LIST_NAME_OF(impl, lastIndexOf)(LIST_NAME_OF(impl, List) list, T o) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		const T* array = typedList->array; \
+		int64_t i = typedList->size; \
+		for (; i >= 8; i -= 8) { \
+			bool found = false; \
+			for (int k = 1; k <= 8; ++k) \
+				found |= isEqual(array[i - k], o); \
+			if (found) \
+				break; \
+		} \
+		for (--i; i >= 0; --i) \
+			if (isEqual(array[i], o)) \
+				return i; \
+		return -1; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, contains)(LIST_NAME_OF(impl, List) list, T o) { \
+		return LIST_NAME_OF(impl, indexOf)(list, o) >= 0; \
+	} \
+	\
+	T* LIST_NAME_OF(impl, toArray)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		T* result = NULL; \
+		result = malloc(sizeof(T) * (typedList->size > 0 ? typedList->size : 1)); \
+		assert(result != NULL); \
+		memcpy(result, typedList->array, sizeof(T) * typedList->size); \
+		return result; \
+	} \
+	\
+	T* LIST_NAME_OF(impl, data)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		return typedList->array; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, add)(LIST_NAME_OF(impl, List) list, T e) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(typedList->file.mapping == NULL); \
+		if (typedList->size == typedList->maxSize) \
+			LIST_NAME_OF(impl, bulkUpdateSize)(typedList, typedList->size + 1); \
+		typedList->array[typedList->size++] = e; \
+		return true; \
+	} \
+	\
+	void LIST_NAME_OF(impl, removeRange)(LIST_NAME_OF(impl, List) list, int64_t fromIndex, int64_t toIndex) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(fromIndex >= 0 && toIndex <= typedList->size && toIndex >= fromIndex); \
+		assert(typedList->file.mapping == NULL); \
+		if (toIndex < typedList->size) \
+			memmove(typedList->array + fromIndex, typedList->array + toIndex, \
+					sizeof(T) * (typedList->size - toIndex)); \
+		typedList->size -= toIndex - fromIndex; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, remove)(LIST_NAME_OF(impl, List) list, T o) { \
+		int64_t i = LIST_NAME_OF(impl, indexOf)(list, o); \
+		if (i < 0) \
+			return false; \
+		LIST_NAME_OF(impl, removeRange)(list, i, i + 1); \
+		return true; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, addAllAt)(LIST_NAME_OF(impl, List) list, int64_t index, const T arr[], size_t arrLength) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(index >= 0 && index <= typedList->size); \
+		assert(typedList->file.mapping == NULL); \
+		LIST_NAME_OF(impl, bulkUpdateSize)(typedList, typedList->size + arrLength); \
+		if (index < typedList->size) \
+			memmove(typedList->array + index + arrLength, typedList->array + index, \
+					sizeof(T) * (typedList->size - index)); \
+		if (arrLength > 0) \
+			memcpy(typedList->array + index, arr, sizeof(T) * arrLength); \
+		typedList->size += arrLength; \
+		return true; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, addAll)(LIST_NAME_OF(impl, List) list, const T arr[], size_t arrLength) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		return LIST_NAME_OF(impl, addAllAt)(list, typedList->size, arr, arrLength); \
+	} \
+	\
+	void LIST_NAME_OF(impl, clear)(LIST_NAME_OF(impl, List) list) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(typedList->file.mapping == NULL); \
+		typedList->size = 0; \
+	} \
+	\
+	bool LIST_NAME_OF(impl, equals)(LIST_NAME_OF(impl, List) list, LIST_NAME_OF(impl, List) o) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		LIST_NAME_OF(impl, Impl)* typedList2 = o; \
+		if (typedList->size != typedList2->size) \
+			return false; \
+		for (int64_t i = 0; i < typedList->size; ++i) \
+			if (!isEqual(typedList->array[i], typedList2->array[i])) \
+				return false; \
+		return true; \
+	} \
+	\
+	T LIST_NAME_OF(impl, get)(LIST_NAME_OF(impl, List) list, int64_t index) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(index >= 0 && index < typedList->size); \
+		return typedList->array[index]; \
+	} \
+	\
+	T LIST_NAME_OF(impl, set)(LIST_NAME_OF(impl, List) list, int64_t index, T element) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(index >= 0 && index < typedList->size); \
+		assert(typedList->file.mapping == NULL); \
+		T result = typedList->array[index]; \
+		typedList->array[index] = element; \
+		return result; \
+	} \
+	\
+	void LIST_NAME_OF(impl, addAt)(LIST_NAME_OF(impl, List) list, int64_t index, T element) { \
+		LIST_NAME_OF(impl, addAllAt)(list, index, &element, 1); \
+	} \
+	\
+	T LIST_NAME_OF(impl, removeAt)(LIST_NAME_OF(impl, List) list, int64_t index) { \
+		LIST_NAME_OF(impl, Impl)* typedList = list; \
+		assert(index >= 0 && index < typedList->size); \
+		T result = typedList->array[index]; \
+		LIST_NAME_OF(impl, removeRange)(list, index, index + 1); \
+		return result; \
+	}
+
+LIST_DECLARE_TYPED(int64, int64_t)
+LIST_DECLARE_TYPED(double, double)
+LIST_DECLARE_TYPED(uint32, uint32_t)
+
+#endif
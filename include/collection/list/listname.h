@@ -0,0 +1,40 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#ifndef LISTNAME_H
+#define LISTNAME_H
+
+/*
+ * Every list implementation exports its functions as
+ * <implementation>_list_<function>, e.g. array_list_add.  LIST_NAME_OF
+ * builds such a name from an implementation and a function name, and
+ * LIST_NAME does the same for the implementation selected by
+ * LIST_IMPLEMENTATION at the point of use.
+ */
+#define LIST_NAME_OF_(implementation, name) implementation##_list_##name
+#define LIST_NAME_OF(implementation, name) LIST_NAME_OF_(implementation, name)
+#define LIST_NAME(name) LIST_NAME_OF(LIST_IMPLEMENTATION, name)
+
+#endif
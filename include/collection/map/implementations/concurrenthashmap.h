@@ -0,0 +1,52 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/map/map.h"
+
+#ifndef CONCURRENTHASHMAP_H
+#define CONCURRENTHASHMAP_H
+
+/*
+ * ConcurrentHashMap: a map that any number of threads may read and update
+ * at the same time without external locking.  The map interface is
+ * declared in map.h.
+ *
+ * Readers (<tt>get</tt>, <tt>containsKey</tt>, <tt>size</tt>,
+ * <tt>isEmpty</tt>) take no lock.  Writers lock one of a fixed set of
+ * stripes chosen by the hash of the key, so writers to different stripes
+ * proceed in parallel; growing the table takes every stripe.  Removed
+ * entries and replaced tables are reclaimed through an epoch domain owned
+ * by the map (see collection/epoch.h), so the allocator must be thread
+ * safe.  <tt>size</tt> is exact only while no writer is running.
+ * <tt>putAll</tt> reads <tt>m</tt> as readers do; <tt>delMap</tt> must not
+ * run concurrently with any other operation.
+ */
+
+#endif
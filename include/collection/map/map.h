@@ -0,0 +1,188 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/map/mapname.h"
+
+#ifndef MAP_IMPLEMENTATION
+#error "MAP_IMPLEMENTATION is not defined and is required for map.h"
+#else
+
+#ifndef MAP_H
+#define MAP_H
+
+// map_<function> names the function of the selected implementation
+#define map_Map MAP_NAME(Map)
+#define map_newMap MAP_NAME(newMap)
+#define map_newMapWithFunctions MAP_NAME(newMapWithFunctions)
+#define map_newMapWithAllocator MAP_NAME(newMapWithAllocator)
+#define map_delMap MAP_NAME(delMap)
+#define map_size MAP_NAME(size)
+#define map_isEmpty MAP_NAME(isEmpty)
+#define map_containsKey MAP_NAME(containsKey)
+#define map_get MAP_NAME(get)
+#define map_put MAP_NAME(put)
+#define map_remove MAP_NAME(remove)
+#define map_putAll MAP_NAME(putAll)
+#define map_clear MAP_NAME(clear)
+
+typedef void* map_Map;
+
+/**
+ * Computes the hash code of a key.  Keys that are equal according to the
+ * map's equals function must have the same hash code.
+ */
+typedef uint64_t (*map_HashFunction)(const void* key);
+
+/**
+ * Returns <tt>true</tt> if two keys are equal.
+ */
+typedef bool (*map_EqualsFunction)(const void* a, const void* b);
+
+/**
+ * Constructs an empty map whose keys are compared by identity, i.e. two
+ * keys are equal only if they are the same pointer.
+ *
+ * @return the new map
+ */
+map_Map map_newMap();
+
+/**
+ * Constructs an empty map whose keys are hashed and compared by the
+ * given functions.
+ *
+ * @param hash hash function for keys
+ * @param equals equality function for keys
+ * @return the new map
+ */
+map_Map map_newMapWithFunctions(map_HashFunction hash, map_EqualsFunction equals);
+
+/**
+ * Constructs an empty map, as by {@link #newMapWithFunctions}, whose
+ * memory is obtained from <tt>allocator</tt>.  Passing <tt>NULL</tt> for
+ * both functions compares keys by identity.
+ *
+ * @param hash hash function for keys, or <tt>NULL</tt>
+ * @param equals equality function for keys, or <tt>NULL</tt>
+ * @param allocator allocator that must outlive the map
+ * @return the new map
+ */
+map_Map map_newMapWithAllocator(map_HashFunction hash, map_EqualsFunction equals,
+		const collection_Allocator* allocator);
+
+bool map_delMap(map_Map);
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of key-value mappings in this map.
+ *
+ * @return the number of key-value mappings in this map
+ */
+int64_t map_size(map_Map);
+
+/**
+ * Returns <tt>true</tt> if this map contains no key-value mappings.
+ *
+ * @return <tt>true</tt> if this map contains no key-value mappings
+ */
+bool map_isEmpty(map_Map);
+
+/**
+ * Returns <tt>true</tt> if this map contains a mapping for the specified
+ * key.
+ *
+ * @param key key whose presence in this map is to be tested
+ * @return <tt>true</tt> if this map contains a mapping for the specified
+ * key
+ */
+bool map_containsKey(map_Map, const void* key);
+
+/**
+ * Returns the value to which the specified key is mapped, or
+ * <tt>NULL</tt> if this map contains no mapping for the key.  A return
+ * value of <tt>NULL</tt> does not necessarily indicate that the map
+ * contains no mapping for the key; the {@link #containsKey} operation may
+ * be used to distinguish these two cases.
+ *
+ * @param key the key whose associated value is to be returned
+ * @return the value to which the specified key is mapped, or
+ * <tt>NULL</tt> if this map contains no mapping for the key
+ */
+void* map_get(map_Map, const void* key);
+
+
+
+// Modification Operations
+
+/**
+ * Associates the specified value with the specified key in this map.  If
+ * the map previously contained a mapping for the key, the old value is
+ * replaced by the specified value and the key already stored is kept.
+ *
+ * @param key key with which the specified value is to be associated
+ * @param value value to be associated with the specified key
+ * @return the previous value associated with <tt>key</tt>, or
+ * <tt>NULL</tt> if there was no mapping for <tt>key</tt>
+ */
+void* map_put(map_Map, void* key, void* value);
+
+/**
+ * Removes the mapping for a key from this map if it is present.
+ *
+ * @param key key whose mapping is to be removed from the map
+ * @return the previous value associated with <tt>key</tt>, or
+ * <tt>NULL</tt> if there was no mapping for <tt>key</tt>
+ */
+void* map_remove(map_Map, const void* key);
+
+
+
+// Bulk Operations
+
+/**
+ * Copies all of the mappings from the specified map to this map.  The
+ * effect of this call is equivalent to that of calling {@link #put} on
+ * this map once for each mapping in the specified map.
+ *
+ * @param m mappings to be stored in this map
+ */
+void map_putAll(map_Map, map_Map m);
+
+/**
+ * Removes all of the mappings from this map.  The map will be empty
+ * after this call returns.
+ */
+void map_clear(map_Map);
+
+#endif
+
+#endif
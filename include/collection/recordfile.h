@@ -0,0 +1,98 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef COLLECTION_RECORDFILE_H
+#define COLLECTION_RECORDFILE_H
+
+/**
+ * Binary files of fixed-size records, written in one pass and read back by
+ * mapping them into memory.  A file starts with a 64 byte header holding a
+ * magic number, a format version, a byte order mark, the record size, the
+ * record count and a hash of the name of the record type, followed by the
+ * records stored contiguously in the byte order of the machine that wrote
+ * them.  Records therefore start 64 bytes into a page aligned mapping and
+ * are suitably aligned for any type.
+ *
+ * Mapping a file costs the same whatever its size: pages are read from
+ * disk the first time they are touched, and are shared with every other
+ * process that maps the same file.
+ */
+typedef struct collection_RecordFile {
+	void* mapping; // NULL when no file is mapped
+	size_t length;
+	const void* records;
+	int64_t count;
+} collection_RecordFile;
+
+/**
+ * Writes <tt>count</tt> records of <tt>recordSize</tt> bytes to the file
+ * at <tt>path</tt>.  The records are written to a uniquely named
+ * temporary file next to it, which is flushed to disk and then renamed
+ * over it, so processes that have the old file mapped keep seeing the old
+ * records, a crash leaves either the old or the new file under
+ * <tt>path</tt>, never a partial one, and of concurrent writers of
+ * <tt>path</tt> the last to rename wins.
+ *
+ * @param path file to create or replace
+ * @param type name of the record type, checked by {@link #mapRecordFile}
+ * @param records the records to write
+ * @param recordSize size of one record in bytes
+ * @param count number of records
+ * @return <tt>true</tt> once the file is written and its directory entry
+ * flushed to disk, <tt>false</tt> if an I/O error occurred, in which case
+ * <tt>errno</tt> describes it
+ */
+bool collection_writeRecordFile(const char* path, const char* type,
+		const void* records, size_t recordSize, int64_t count);
+
+/**
+ * Maps the record file at <tt>path</tt> read-only into memory.
+ *
+ * @param file receives the mapping and the location and number of its
+ * records
+ * @param path file to map
+ * @param type name of the record type, which must match the name the file
+ * was written with
+ * @param recordSize size of one record in bytes, which must match the
+ * size recorded in the file
+ * @return <tt>true</tt> if the file was mapped, <tt>false</tt> if it could
+ * not be opened or mapped, or is not a record file of
+ * <tt>recordSize</tt> byte records of <tt>type</tt> written on a machine
+ * of the same byte order
+ */
+bool collection_mapRecordFile(collection_RecordFile* file, const char* path,
+		const char* type, size_t recordSize);
+
+/**
+ * Unmaps a file mapped by {@link #mapRecordFile}.  Its records must not
+ * be used afterwards.
+ */
+void collection_unmapRecordFile(collection_RecordFile* file);
+
+#endif
@@ -0,0 +1,209 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "collection/allocator.h"
+#include "collection/set/setname.h"
+
+#ifndef SET_IMPLEMENTATION
+#error "SET_IMPLEMENTATION is not defined and is required for set.h"
+#else
+
+#ifndef SET_H
+#define SET_H
+
+// set_<function> names the function of the selected implementation
+#define set_Set SET_NAME(Set)
+#define set_newSet SET_NAME(newSet)
+#define set_newSetWithFunctions SET_NAME(newSetWithFunctions)
+#define set_newSetWithAllocator SET_NAME(newSetWithAllocator)
+#define set_delSet SET_NAME(delSet)
+#define set_reserve SET_NAME(reserve)
+#define set_size SET_NAME(size)
+#define set_isEmpty SET_NAME(isEmpty)
+#define set_contains SET_NAME(contains)
+#define set_iterate SET_NAME(iterate)
+#define set_add SET_NAME(add)
+#define set_remove SET_NAME(remove)
+#define set_containsAll SET_NAME(containsAll)
+#define set_addAll SET_NAME(addAll)
+#define set_clear SET_NAME(clear)
+
+typedef void* set_Set;
+
+/**
+ * Computes the hash code of an element.  Elements that are equal
+ * according to the set's equals function must have the same hash code.
+ */
+typedef uint64_t (*set_HashFunction)(const void* e);
+
+/**
+ * Returns <tt>true</tt> if two elements are equal.
+ */
+typedef bool (*set_EqualsFunction)(const void* a, const void* b);
+
+/**
+ * Constructs an empty set whose elements are compared by identity, i.e.
+ * two elements are equal only if they are the same pointer.
+ *
+ * @return the new set
+ */
+set_Set set_newSet();
+
+/**
+ * Constructs an empty set whose elements are hashed and compared by the
+ * given functions.
+ *
+ * @param hash hash function for elements
+ * @param equals equality function for elements
+ * @return the new set
+ */
+set_Set set_newSetWithFunctions(set_HashFunction hash, set_EqualsFunction equals);
+
+/**
+ * Constructs an empty set, as by {@link #newSetWithFunctions}, whose
+ * memory is obtained from <tt>allocator</tt>.  Passing <tt>NULL</tt> for
+ * both functions compares elements by identity.
+ *
+ * @param hash hash function for elements, or <tt>NULL</tt>
+ * @param equals equality function for elements, or <tt>NULL</tt>
+ * @param allocator allocator that must outlive the set
+ * @return the new set
+ */
+set_Set set_newSetWithAllocator(set_HashFunction hash, set_EqualsFunction equals,
+		const collection_Allocator* allocator);
+
+bool set_delSet(set_Set);
+
+/**
+ * Sizes the table so that it can hold at least <tt>minSize</tt> elements
+ * without growing.  The table uses 9 bytes per slot and is filled up to
+ * 7/8, so a set reserved for 1M pointers takes about 10 MB.  A set that
+ * grows by {@link #add} alone grows its table by half each time, and so
+ * takes up to 1.5 times as much; reserve to get the tight footprint.
+ *
+ * @param minSize the number of elements to make room for
+ */
+void set_reserve(set_Set, int64_t minSize);
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of elements in this set.
+ *
+ * @return the number of elements in this set
+ */
+int64_t set_size(set_Set);
+
+/**
+ * Returns <tt>true</tt> if this set contains no elements.
+ *
+ * @return <tt>true</tt> if this set contains no elements
+ */
+bool set_isEmpty(set_Set);
+
+/**
+ * Returns <tt>true</tt> if this set contains the specified element.
+ *
+ * @param o element whose presence in this set is to be tested
+ * @return <tt>true</tt> if this set contains the specified element
+ */
+bool set_contains(set_Set, const void* o);
+
+/**
+ * Advances an iteration over the elements of this set.  Start with
+ * <tt>*position</tt> set to 0 and call repeatedly; each call stores the
+ * next element in <tt>*element</tt>.  Elements are returned in no
+ * particular order.  The behavior is undefined if the set is modified
+ * during the iteration, except through {@link #remove} of the element
+ * just returned.
+ *
+ * @param position iteration state, 0 to start
+ * @param element receives the next element
+ * @return <tt>false</tt> once every element has been returned
+ */
+bool set_iterate(set_Set, int64_t* position, void** element);
+
+
+
+// Modification Operations
+
+/**
+ * Adds the specified element to this set if it is not already present.
+ *
+ * @param e element to be added to this set
+ * @return <tt>true</tt> if this set did not already contain the specified
+ * element
+ */
+bool set_add(set_Set, void* e);
+
+/**
+ * Removes the specified element from this set if it is present.
+ *
+ * @param o element to be removed from this set, if present
+ * @return <tt>true</tt> if this set contained the specified element
+ */
+bool set_remove(set_Set, const void* o);
+
+
+
+// Bulk Operations
+
+/**
+ * Returns <tt>true</tt> if this set contains all of the elements of the
+ * specified array.
+ *
+ * @param arr elements to be checked for containment in this set
+ * @return <tt>true</tt> if this set contains all of the elements of the
+ * specified array
+ * @see #contains(void*)
+ */
+bool set_containsAll(set_Set, void* arr[], size_t arrLength);
+
+/**
+ * Adds all of the elements in the specified array to this set if they're
+ * not already present.  The table is grown once up front rather than
+ * step by step.
+ *
+ * @param arr elements to be added to this set
+ * @return <tt>true</tt> if this set changed as a result of the call
+ * @see #add(void*)
+ */
+bool set_addAll(set_Set, void* arr[], size_t arrLength);
+
+/**
+ * Removes all of the elements from this set.  The set will be empty after
+ * this call returns.
+ */
+void set_clear(set_Set);
+
+#endif
+
+#endif
@@ -0,0 +1,270 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "collection/allocator.h"
+
+#define ALIGNMENT _Alignof(max_align_t)
+#define ALIGN_UP(n) (((n) + ALIGNMENT - 1) & ~(ALIGNMENT - 1))
+
+static void* stdAllocate(void* context, size_t size) {
+	return malloc(size);
+}
+
+static void* stdReallocate(void* context, void* ptr, size_t oldSize, size_t newSize) {
+	return realloc(ptr, newSize);
+}
+
+static void stdDeallocate(void* context, void* ptr, size_t size) {
+	free(ptr);
+}
+
+const collection_Allocator collection_stdAllocator = {
+	stdAllocate, stdReallocate, stdDeallocate, NULL
+};
+
+
+
+// Arena
+
+typedef struct ArenaBlock {
+	struct ArenaBlock* next;
+	size_t capacity;
+	size_t used;
+	max_align_t data[];
+} ArenaBlock;
+
+struct collection_Arena {
+	collection_Allocator allocator;
+	ArenaBlock* blocks; // current block first
+	size_t blockSize;
+};
+
+static ArenaBlock* newArenaBlock(size_t capacity, ArenaBlock* next) {
+	ArenaBlock* block = malloc(sizeof(ArenaBlock) + capacity);
+	assert(block != NULL);
+	block->next = next;
+	block->capacity = capacity;
+	block->used = 0;
+	return block;
+}
+
+static void* arenaAllocate(void* context, size_t size) {
+	collection_Arena* arena = context;
+	size = ALIGN_UP(size);
+	ArenaBlock* block = arena->blocks;
+	if (block->capacity - block->used < size) {
+		size_t capacity = size > arena->blockSize ? size : arena->blockSize;
+		block = arena->blocks = newArenaBlock(capacity, block);
+	}
+	void* result = (char*) block->data + block->used;
+	block->used += size;
+	return result;
+}
+
+/*
+ * Returns whether the size bytes at ptr end at the bump pointer of the
+ * current block, so that they can be resized or released in place.  This
+ * holds for the most recent allocation, and again for each earlier one
+ * once those after it were released, so blocks released in the reverse
+ * order of their allocation are all reclaimed.
+ */
+static bool endsBlock(collection_Arena* arena, void* ptr, size_t size) {
+	ArenaBlock* block = arena->blocks;
+	return (char*) ptr + ALIGN_UP(size) == (char*) block->data + block->used;
+}
+
+static void* arenaReallocate(void* context, void* ptr, size_t oldSize, size_t newSize) {
+	collection_Arena* arena = context;
+	if (ptr == NULL)
+		return arenaAllocate(context, newSize);
+	ArenaBlock* block = arena->blocks;
+	if (endsBlock(arena, ptr, oldSize)) {
+		// the allocation can grow or shrink without moving
+		size_t start = block->used - ALIGN_UP(oldSize);
+		if (block->capacity - start >= ALIGN_UP(newSize)) {
+			block->used = start + ALIGN_UP(newSize);
+			return ptr;
+		}
+	}
+	void* result = arenaAllocate(context, newSize);
+	memcpy(result, ptr, oldSize < newSize ? oldSize : newSize);
+	return result;
+}
+
+static void arenaDeallocate(void* context, void* ptr, size_t size) {
+	collection_Arena* arena = context;
+	if (ptr != NULL && endsBlock(arena, ptr, size))
+		arena->blocks->used -= ALIGN_UP(size);
+}
+
+collection_Arena* collection_newArena(size_t blockSize) {
+	collection_Arena* arena = NULL;
+	arena = malloc(sizeof(collection_Arena));
+	assert(arena != NULL);
+	arena->allocator.allocate = arenaAllocate;
+	arena->allocator.reallocate = arenaReallocate;
+	arena->allocator.deallocate = arenaDeallocate;
+	arena->allocator.context = arena;
+	arena->blockSize = ALIGN_UP(blockSize);
+	arena->blocks = newArenaBlock(arena->blockSize, NULL);
+	return arena;
+}
+
+void collection_delArena(collection_Arena* arena) {
+	ArenaBlock* block = arena->blocks;
+	while (block != NULL) {
+		ArenaBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	free(arena);
+}
+
+void collection_resetArena(collection_Arena* arena) {
+	ArenaBlock* block = arena->blocks;
+	while (block->next != NULL) {
+		ArenaBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	// the oldest block is always a regular sized one
+	block->used = 0;
+	arena->blocks = block;
+}
+
+const collection_Allocator* collection_arenaAllocator(collection_Arena* arena) {
+	return &arena->allocator;
+}
+
+
+
+// Pool
+
+typedef struct PoolSlot {
+	struct PoolSlot* next;
+} PoolSlot;
+
+typedef struct PoolBlock {
+	struct PoolBlock* next;
+	max_align_t data[];
+} PoolBlock;
+
+struct collection_Pool {
+	collection_Allocator allocator;
+	PoolBlock* blocks;
+	PoolSlot* freeSlots;
+	size_t slotSize;
+	size_t slotsPerBlock;
+};
+
+static void refillPool(collection_Pool* pool) {
+	PoolBlock* block = malloc(sizeof(PoolBlock) + pool->slotSize * pool->slotsPerBlock);
+	assert(block != NULL);
+	block->next = pool->blocks;
+	pool->blocks = block;
+	for (size_t i = pool->slotsPerBlock; i > 0; --i) {
+		PoolSlot* slot = (PoolSlot*) ((char*) block->data + (i - 1) * pool->slotSize);
+		slot->next = pool->freeSlots;
+		pool->freeSlots = slot;
+	}
+}
+
+static void* poolAllocate(void* context, size_t size) {
+	collection_Pool* pool = context;
+	if (size > pool->slotSize)
+		return malloc(size);
+	if (pool->freeSlots == NULL)
+		refillPool(pool);
+	PoolSlot* slot = pool->freeSlots;
+	pool->freeSlots = slot->next;
+	return slot;
+}
+
+static void poolDeallocate(void* context, void* ptr, size_t size) {
+	collection_Pool* pool = context;
+	if (ptr == NULL)
+		return;
+	if (size > pool->slotSize) {
+		free(ptr);
+		return;
+	}
+	PoolSlot* slot = ptr;
+	slot->next = pool->freeSlots;
+	pool->freeSlots = slot;
+}
+
+static void* poolReallocate(void* context, void* ptr, size_t oldSize, size_t newSize) {
+	collection_Pool* pool = context;
+	if (ptr == NULL)
+		return poolAllocate(context, newSize);
+	bool wasSlot = oldSize <= pool->slotSize;
+	bool isSlot = newSize <= pool->slotSize;
+	if (wasSlot && isSlot)
+		return ptr;
+	if (!wasSlot && !isSlot)
+		return realloc(ptr, newSize);
+	void* result = poolAllocate(context, newSize);
+	if (result != NULL) {
+		memcpy(result, ptr, oldSize < newSize ? oldSize : newSize);
+		poolDeallocate(context, ptr, oldSize);
+	}
+	return result;
+}
+
+collection_Pool* collection_newPool(size_t slotSize, size_t slotsPerBlock) {
+	assert(slotsPerBlock > 0);
+	collection_Pool* pool = NULL;
+	pool = malloc(sizeof(collection_Pool));
+	assert(pool != NULL);
+	pool->allocator.allocate = poolAllocate;
+	pool->allocator.reallocate = poolReallocate;
+	pool->allocator.deallocate = poolDeallocate;
+	pool->allocator.context = pool;
+	pool->blocks = NULL;
+	pool->freeSlots = NULL;
+	pool->slotSize = ALIGN_UP(slotSize < sizeof(PoolSlot) ? sizeof(PoolSlot) : slotSize);
+	pool->slotsPerBlock = slotsPerBlock;
+	return pool;
+}
+
+void collection_delPool(collection_Pool* pool) {
+	PoolBlock* block = pool->blocks;
+	while (block != NULL) {
+		PoolBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	free(pool);
+}
+
+const collection_Allocator* collection_poolAllocator(collection_Pool* pool) {
+	return &pool->allocator;
+}
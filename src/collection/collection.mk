@@ -5,7 +5,25 @@ endif
 
 CURRENT_DIR:=$(CURRENT_DIR)/collection
 
-all: list
+export COLLECTION_OBJ:= $(BASE_DIR)/$(CURRENT_DIR)/allocator.o $(BASE_DIR)/$(CURRENT_DIR)/epoch.o $(BASE_DIR)/$(CURRENT_DIR)/recordfile.o
 
-list: list/*
+all: allocator.o epoch.o recordfile.o list map set
+
+.PHONY: list map set
+list: list/* allocator.o epoch.o recordfile.o
 	$(MAKE) -C $(BASE_DIR)/$(CURRENT_DIR)/list -f list.mk
+
+map: map/* allocator.o epoch.o recordfile.o
+	$(MAKE) -C $(BASE_DIR)/$(CURRENT_DIR)/map -f map.mk
+
+set: set/* allocator.o epoch.o recordfile.o
+	$(MAKE) -C $(BASE_DIR)/$(CURRENT_DIR)/set -f set.mk
+
+allocator.o: $(BASE_DIR)/include/collection/allocator.h allocator.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include allocator.c
+
+epoch.o: $(BASE_DIR)/include/collection/epoch.h epoch.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include epoch.c
+
+recordfile.o: $(BASE_DIR)/include/collection/recordfile.h recordfile.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include recordfile.c
@@ -0,0 +1,236 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "collection/allocator.h"
+#include "collection/epoch.h"
+
+/*
+ * Classic three-epoch scheme.  The domain has a global epoch; a thread in a
+ * critical section publishes the epoch it entered in, and the global epoch
+ * only advances when every thread inside a critical section has entered in
+ * the current one.  A block retired during epoch e can therefore be
+ * deallocated once the global epoch reaches e + 2.
+ *
+ * Records are found through a small per-thread cache keyed by a domain id,
+ * so that a domain reallocated at the address of a deleted one is not
+ * mistaken for it.  Each record keeps the blocks its thread retired; only
+ * the owning thread touches them.
+ *
+ * A thread collects its blocks once it has retired COLLECT_THRESHOLD of
+ * them or COLLECT_BYTES worth, so that a few large blocks, such as the
+ * arrays a growing list leaves behind, are not held until many more are
+ * retired.  Collecting advances the epoch twice if it can, so that when no
+ * thread is inside a critical section every retired block is deallocated
+ * at once.
+ */
+
+#define CACHE_SIZE 8
+#define COLLECT_THRESHOLD 64
+#define COLLECT_BYTES (64 * 1024)
+#define INIT_RETIRED_CAPACITY 64
+
+typedef struct {
+	void* ptr;
+	size_t size;
+	uint64_t epoch;
+} Retired;
+
+typedef struct Record {
+	_Atomic uint64_t epoch; // 0 outside critical sections
+	pthread_t owner;
+	int64_t nesting;
+	Retired* retired;
+	int64_t retiredCount;
+	int64_t retiredCapacity;
+	size_t retiredBytes;
+	int64_t nextCollect;
+	size_t nextCollectBytes;
+	struct Record* next;
+} Record;
+
+struct collection_EpochDomain {
+	_Atomic uint64_t epoch;
+	_Atomic(Record*) records;
+	uint64_t id;
+	const collection_Allocator* allocator;
+};
+
+typedef struct {
+	uint64_t id;
+	Record* record;
+} CacheEntry;
+
+static _Atomic uint64_t nextDomainId = 1;
+static _Thread_local CacheEntry cache[CACHE_SIZE];
+
+static Record* newRecord(collection_EpochDomain* domain) {
+	const collection_Allocator* allocator = domain->allocator;
+	Record* record = allocator->allocate(allocator->context, sizeof(Record));
+	assert(record != NULL);
+	atomic_init(&record->epoch, 0);
+	record->owner = pthread_self();
+	record->nesting = 0;
+	record->retired = allocator->allocate(allocator->context,
+			sizeof(Retired) * INIT_RETIRED_CAPACITY);
+	assert(record->retired != NULL);
+	record->retiredCount = 0;
+	record->retiredCapacity = INIT_RETIRED_CAPACITY;
+	record->retiredBytes = 0;
+	record->nextCollect = COLLECT_THRESHOLD;
+	record->nextCollectBytes = COLLECT_BYTES;
+	record->next = atomic_load(&domain->records);
+	while (!atomic_compare_exchange_weak(&domain->records, &record->next, record))
+		;
+	return record;
+}
+
+static Record* recordOf(collection_EpochDomain* domain) {
+	CacheEntry* entry = &cache[domain->id & (CACHE_SIZE - 1)];
+	if (entry->id == domain->id)
+		return entry->record;
+	Record* record = atomic_load(&domain->records);
+	pthread_t self = pthread_self();
+	while (record != NULL && !pthread_equal(record->owner, self))
+		record = record->next;
+	if (record == NULL)
+		record = newRecord(domain);
+	entry->id = domain->id;
+	entry->record = record;
+	return record;
+}
+
+static bool tryAdvance(collection_EpochDomain* domain) {
+	uint64_t epoch = atomic_load(&domain->epoch);
+	for (Record* record = atomic_load(&domain->records); record != NULL; record = record->next) {
+		uint64_t recordEpoch = atomic_load(&record->epoch);
+		if (recordEpoch != 0 && recordEpoch != epoch)
+			return false;
+	}
+	return atomic_compare_exchange_strong(&domain->epoch, &epoch, epoch + 1);
+}
+
+static void collect(collection_EpochDomain* domain, Record* record) {
+	const collection_Allocator* allocator = domain->allocator;
+	if (tryAdvance(domain))
+		tryAdvance(domain);
+	uint64_t epoch = atomic_load(&domain->epoch);
+	int64_t kept = 0;
+	size_t keptBytes = 0;
+	for (int64_t i = 0; i < record->retiredCount; ++i) {
+		Retired* retired = &record->retired[i];
+		if (retired->epoch + 2 <= epoch)
+			allocator->deallocate(allocator->context, retired->ptr, retired->size);
+		else {
+			record->retired[kept++] = *retired;
+			keptBytes += retired->size;
+		}
+	}
+	record->retiredCount = kept;
+	record->retiredBytes = keptBytes;
+	// back off while a reader holds the epoch so that collecting stays linear,
+	// but by a fixed number of bytes so that large blocks are not held long
+	record->nextCollect = kept * 2 > COLLECT_THRESHOLD ? kept * 2 : COLLECT_THRESHOLD;
+	record->nextCollectBytes = keptBytes + COLLECT_BYTES;
+}
+
+collection_EpochDomain* collection_newEpochDomain(const collection_Allocator* allocator) {
+	collection_EpochDomain* domain = allocator->allocate(allocator->context,
+			sizeof(collection_EpochDomain));
+	assert(domain != NULL);
+	atomic_init(&domain->epoch, 1);
+	atomic_init(&domain->records, NULL);
+	domain->id = atomic_fetch_add(&nextDomainId, 1);
+	domain->allocator = allocator;
+	return domain;
+}
+
+void collection_delEpochDomain(collection_EpochDomain* domain) {
+	const collection_Allocator* allocator = domain->allocator;
+	Record* record = atomic_load(&domain->records);
+	while (record != NULL) {
+		Record* next = record->next;
+		assert(atomic_load(&record->epoch) == 0);
+		for (int64_t i = 0; i < record->retiredCount; ++i)
+			allocator->deallocate(allocator->context, record->retired[i].ptr,
+					record->retired[i].size);
+		allocator->deallocate(allocator->context, record->retired,
+				sizeof(Retired) * record->retiredCapacity);
+		allocator->deallocate(allocator->context, record, sizeof(Record));
+		record = next;
+	}
+	allocator->deallocate(allocator->context, domain, sizeof(collection_EpochDomain));
+}
+
+void collection_epochEnter(collection_EpochDomain* domain) {
+	Record* record = recordOf(domain);
+	if (record->nesting++ > 0)
+		return;
+	// publish the epoch, then check it did not move before it became visible
+	uint64_t epoch = atomic_load(&domain->epoch);
+	for (;;) {
+		atomic_store(&record->epoch, epoch);
+		uint64_t current = atomic_load(&domain->epoch);
+		if (current == epoch)
+			return;
+		epoch = current;
+	}
+}
+
+void collection_epochExit(collection_EpochDomain* domain) {
+	Record* record = recordOf(domain);
+	assert(record->nesting > 0);
+	if (--record->nesting == 0)
+		atomic_store_explicit(&record->epoch, 0, memory_order_release);
+}
+
+void collection_epochRetire(collection_EpochDomain* domain, void* ptr, size_t size) {
+	Record* record = recordOf(domain);
+	if (record->retiredCount == record->retiredCapacity) {
+		const collection_Allocator* allocator = domain->allocator;
+		record->retired = allocator->reallocate(allocator->context, record->retired,
+				sizeof(Retired) * record->retiredCapacity,
+				sizeof(Retired) * record->retiredCapacity * 2);
+		assert(record->retired != NULL);
+		record->retiredCapacity *= 2;
+	}
+	Retired retired = { ptr, size, atomic_load(&domain->epoch) };
+	record->retired[record->retiredCount++] = retired;
+	record->retiredBytes += size;
+	if (record->retiredCount >= record->nextCollect
+			|| record->retiredBytes >= record->nextCollectBytes)
+		collect(domain, record);
+}
+
+void collection_epochCollect(collection_EpochDomain* domain) {
+	collect(domain, recordOf(domain));
+}
@@ -0,0 +1,886 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "collection/allocator.h"
+
+#define LIST_IMPLEMENTATION deque
+#include "collection/list/implementations/arraydeque.h"
+#include "multiset.h"
+
+/*
+ * Circular buffer.  The elements of the deque occupy the slots
+ * head, head + 1, ... of array, wrapping around at the end; the capacity
+ * is a power of two so an index wraps with a mask instead of a branch or
+ * a division.  Inserting or removing at a position moves the elements on
+ * whichever side of it is shorter, so both ends cost O(1).
+ *
+ * A subList is a view holding an offset into the root deque, which owns
+ * the buffer.  Structural changes made through a view are applied to the
+ * root and reflected in the sizes of the view and its enclosing views.
+ */
+
+#define INIT_CAPACITY 16
+
+typedef struct ArrayDeque {
+	void** array; // root only
+	int64_t head; // root only
+	int64_t capacity; // root only, always a power of two
+	int64_t size;
+	int64_t offset; // index of the first element of a view in the root
+	struct ArrayDeque* superList;
+	struct ArrayDeque* root;
+	const collection_Allocator* allocator;
+} ArrayDeque;
+
+static void** slotAt(ArrayDeque* root, int64_t index) {
+	return &root->array[(root->head + index) & (root->capacity - 1)];
+}
+
+static void** elementAt(ArrayDeque* deque, int64_t index) {
+	return slotAt(deque->root, deque->offset + index);
+}
+
+/*
+ * Splits the elements [from, from + length) of deque into at most two
+ * contiguous runs of the buffer.  Returns the number of runs.
+ */
+static int spans(ArrayDeque* deque, int64_t from, int64_t length,
+		void** span[2], int64_t spanLength[2]) {
+	if (length == 0)
+		return 0;
+	ArrayDeque* root = deque->root;
+	int64_t start = (root->head + deque->offset + from) & (root->capacity - 1);
+	int64_t first = root->capacity - start;
+	span[0] = root->array + start;
+	if (length <= first) {
+		spanLength[0] = length;
+		return 1;
+	}
+	spanLength[0] = first;
+	span[1] = root->array;
+	spanLength[1] = length - first;
+	return 2;
+}
+
+static void growTo(ArrayDeque* root, int64_t minCapacity) {
+	if (minCapacity <= root->capacity)
+		return;
+	int64_t newCapacity = root->capacity;
+	while (newCapacity < minCapacity)
+		newCapacity <<= 1;
+	const collection_Allocator* allocator = root->allocator;
+	void** newArray = allocator->allocate(allocator->context, sizeof(void*) * newCapacity);
+	assert(newArray != NULL);
+	void** span[2];
+	int64_t spanLength[2];
+	int count = spans(root, 0, root->size, span, spanLength);
+	int64_t copied = 0;
+	for (int i = 0; i < count; ++i) {
+		memcpy(newArray + copied, span[i], sizeof(void*) * spanLength[i]);
+		copied += spanLength[i];
+	}
+	allocator->deallocate(allocator->context, root->array, sizeof(void*) * root->capacity);
+	root->array = newArray;
+	root->capacity = newCapacity;
+	root->head = 0;
+}
+
+static void adjustSizes(ArrayDeque* deque, int64_t delta) {
+	for (ArrayDeque* view = deque; view != view->root; view = view->superList)
+		view->size += delta;
+	deque->root->size += delta;
+}
+
+/*
+ * Makes room for n elements before position index of deque.  The new
+ * slots are left uninitialized.
+ */
+static void openGap(ArrayDeque* deque, int64_t index, int64_t n) {
+	ArrayDeque* root = deque->root;
+	growTo(root, root->size + n);
+	int64_t at = deque->offset + index;
+	if (at < root->size - at) {
+		root->head = (root->head - n) & (root->capacity - 1);
+		for (int64_t i = 0; i < at; ++i)
+			*slotAt(root, i) = *slotAt(root, i + n);
+	} else
+		for (int64_t i = root->size - 1; i >= at; --i)
+			*slotAt(root, i + n) = *slotAt(root, i);
+	adjustSizes(deque, n);
+}
+
+/*
+ * Removes the elements [from, to) of deque.
+ */
+static void closeGap(ArrayDeque* deque, int64_t from, int64_t to) {
+	ArrayDeque* root = deque->root;
+	int64_t n = to - from;
+	int64_t at = deque->offset + from;
+	if (n == 0)
+		return;
+	if (at < root->size - at - n) {
+		for (int64_t i = at - 1; i >= 0; --i)
+			*slotAt(root, i + n) = *slotAt(root, i);
+		root->head = (root->head + n) & (root->capacity - 1);
+	} else
+		for (int64_t i = at; i < root->size - n; ++i)
+			*slotAt(root, i) = *slotAt(root, i + n);
+	adjustSizes(deque, -n);
+}
+
+list_List list_newList() {
+	return list_newListWithAllocator(&collection_stdAllocator);
+}
+
+/**
+ * Constructs an empty list whose header, backing array and any scratch
+ * memory used by its operations are obtained from <tt>allocator</tt>.
+ * Arrays returned by {@link #toArray} are still allocated with
+ * <tt>malloc</tt> since their ownership passes to the caller.
+ *
+ * @param allocator allocator that must outlive the list
+ * @return the new list
+ */
+list_List list_newListWithAllocator(const collection_Allocator* allocator) {
+	ArrayDeque* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(ArrayDeque));
+	assert(result != NULL);
+	memset(result, 0, sizeof(ArrayDeque));
+	result->array = allocator->allocate(allocator->context, sizeof(void*) * INIT_CAPACITY);
+	assert(result->array != NULL);
+	result->capacity = INIT_CAPACITY;
+	result->root = result;
+	result->allocator = allocator;
+	return (list_List) result;
+}
+
+bool list_delList(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	const collection_Allocator* allocator = deque->allocator;
+	if (deque->superList == NULL)
+		allocator->deallocate(allocator->context, deque->array, sizeof(void*) * deque->capacity);
+	allocator->deallocate(allocator->context, deque, sizeof(ArrayDeque));
+	return true;
+}
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of elements in this list.  If this list contains
+ * more than <tt>Integer.MAX_VALUE</tt> elements, returns
+ * <tt>Integer.MAX_VALUE</tt>.
+ *
+ * @return the number of elements in this list
+ */
+int64_t list_size(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	return deque->size;
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains no elements.
+ *
+ * @return <tt>true</tt> if this list contains no elements
+ */
+bool list_isEmpty(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	return deque->size == 0;
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains the specified element.
+ * More formally, returns <tt>true</tt> if and only if this list contains
+ * at least one element <tt>e</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;e==null&nbsp;:&nbsp;o.equals(e))</tt>.
+ *
+ * @param o element whose presence in this list is to be tested
+ * @return <tt>true</tt> if this list contains the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+bool list_contains(list_List list, void* o) {
+	return list_indexOf(list, o) >= 0;
+}
+
+/**
+ * Returns an array containing all of the elements in this list in proper
+ * sequence (from first to last element).
+ *
+ * <p>The returned array will be "safe" in that no references to it are
+ * maint64_tained by this list.  (In other words, this method must
+ * allocate a new array even if this list is backed by an array).
+ * The caller is thus free to modify the returned array.
+ *
+ * <p>This method acts as bridge between array-based and collection-based
+ * APIs.
+ *
+ * @return an array containing all of the elements in this list in proper
+ * sequence
+ */
+void** list_toArray(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	void** result = NULL;
+	result = malloc(sizeof(void*) * (deque->size > 0 ? deque->size : 1));
+	assert(result != NULL);
+	void** span[2];
+	int64_t spanLength[2];
+	int count = spans(deque, 0, deque->size, span, spanLength);
+	int64_t copied = 0;
+	for (int i = 0; i < count; ++i) {
+		memcpy(result + copied, span[i], sizeof(void*) * spanLength[i]);
+		copied += spanLength[i];
+	}
+	return result;
+}
+
+
+
+// Modification Operations
+
+/**
+ * Appends the specified element to the end of this list (optional
+ * operation).
+ *
+ * <p>Lists that support this operation may place limitations on what
+ * elements may be added to this list.  In particular, some
+ * lists will refuse to add null elements, and others will impose
+ * restrictions on the type of elements that may be added.  List
+ * classes should clearly specify in their documentation any restrictions
+ * on what elements may be added.
+ *
+ * @param e element to be appended to this list
+ * @return <tt>true</tt> (as specified by {@link Collection#add})
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements
+ * @throws IllegalArgumentException if some property of this element
+ * prevents it from being added to this list
+ */
+bool list_add(list_List list, void* e) {
+	list_addLast(list, e);
+	return true;
+}
+
+/**
+ * Removes the first occurrence of the specified element from this list,
+ * if it is present (optional operation).  If this list does not contain
+ * the element, it is unchanged.  More formally, removes the element with
+ * the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>
+ * (if such an element exists).  Returns <tt>true</tt> if this list
+ * contained the specified element (or equivalently, if this list changed
+ * as a result of the call).
+ *
+ * @param o element to be removed from this list, if present
+ * @return <tt>true</tt> if this list contained the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ */
+bool list_remove(list_List list, void* o) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	int64_t index = list_indexOf(list, o);
+	if (index < 0)
+		return false;
+	closeGap(deque, index, index + 1);
+	return true;
+}
+
+
+
+// Bulk Modification Operations
+
+/**
+ * Returns <tt>true</tt> if this list contains all of the elements of the
+ * specified collection.
+ *
+ * @param  c collection to be checked for containment in this list
+ * @return <tt>true</tt> if this list contains all of the elements of the
+ * specified collection
+ * @throws ClassCastException if the types of one or more elements
+ * in the specified collection are incompatible with this
+ * list (optional)
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements (optional), or if the specified collection is null
+ * @see #contains(void*)
+ */
+bool list_containsAll(list_List list, void* arr[], size_t arrLength) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	if (arrLength > (size_t) deque->size)
+		return false;
+	Multiset set;
+	multisetInit(&set, deque->allocator, arr, arrLength);
+	// each deque element may satisfy at most one occurrence in arr
+	size_t remaining = arrLength;
+	for (int64_t i = 0; i < deque->size && remaining > 0; ++i)
+		if (multisetTake(&set, *elementAt(deque, i)))
+			--remaining;
+	multisetFree(&set);
+	return remaining == 0;
+}
+
+/*
+ * Stable compaction shared by removeAll and retainAll, with the matching
+ * rules of the ArrayList: every occurrence in arr matches the first equal
+ * element not matched yet.
+ */
+static bool filterDeque(ArrayDeque* deque, void* arr[], size_t arrLength, bool retain) {
+	Multiset set;
+	multisetInit(&set, deque->allocator, arr, arrLength);
+	int64_t newSize = 0;
+	for (int64_t i = 0; i < deque->size; ++i) {
+		void* e = *elementAt(deque, i);
+		if (multisetTake(&set, e) == retain)
+			*elementAt(deque, newSize++) = e;
+	}
+	multisetFree(&set);
+	bool changed = newSize != deque->size;
+	closeGap(deque, newSize, deque->size);
+	return changed;
+}
+
+/**
+ * Appends all of the elements in the specified collection to the end of
+ * this list, in the order that they are returned by the specified
+ * collection's iterator (optional operation).  The behavior of this
+ * operation is undefined if the specified collection is modified while
+ * the operation is in progress.  (Note that this will occur if the
+ * specified collection is this list, and it's nonempty.)
+ *
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @see #add(void*)
+ */
+bool list_addAll(list_List list, void* arr[], size_t arrLength) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	return list_addAllAt(list, deque->size, arr, arrLength);
+}
+
+/**
+ * Inserts all of the elements in the specified collection int64_to this
+ * list at the specified position (optional operation).  Shifts the
+ * element currently at that position (if any) and any subsequent
+ * elements to the right (increases their indices).  The new elements
+ * will appear in this list in the order that they are returned by the
+ * specified collection's iterator.  The behavior of this operation is
+ * undefined if the specified collection is modified while the
+ * operation is in progress.  (Note that this will occur if the specified
+ * collection is this list, and it's nonempty.)
+ *
+ * @param index index at which to insert the first element from the
+ *  specified collection
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+bool list_addAllAt(list_List list, int64_t index, void* arr[], size_t arrLength) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(index >= 0 && index <= deque->size);
+	openGap(deque, index, arrLength);
+	void** span[2];
+	int64_t spanLength[2];
+	int count = spans(deque, index, arrLength, span, spanLength);
+	int64_t copied = 0;
+	for (int i = 0; i < count; ++i) {
+		memcpy(span[i], arr + copied, sizeof(void*) * spanLength[i]);
+		copied += spanLength[i];
+	}
+	return true;
+}
+
+/**
+ * Removes from this list all of its elements that are contained in the
+ * specified collection (optional operation).
+ *
+ * @param c collection containing elements to be removed from this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>removeAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_removeAll(list_List list, void* arr[], size_t arrLength) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	return filterDeque(deque, arr, arrLength, false);
+}
+
+/**
+ * Retains only the elements in this list that are contained in the
+ * specified collection (optional operation).  In other words, removes
+ * from this list all of its elements that are not contained in the
+ * specified collection.
+ *
+ * @param c collection containing elements to be retained in this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>retainAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_retainAll(list_List list, void* arr[], size_t arrLength) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	return filterDeque(deque, arr, arrLength, true);
+}
+
+/**
+ * Removes all of the elements from this list (optional operation).
+ * The list will be empty after this call returns.
+ *
+ * @throws UnsupportedOperationException if the <tt>clear</tt> operation
+ * is not supported by this list
+ */
+void list_clear(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	closeGap(deque, 0, deque->size);
+}
+
+
+
+// Comparison and hashing
+
+/**
+ * Compares the specified object with this list for equality.  Returns
+ * <tt>true</tt> if and only if the specified object is also a list, both
+ * lists have the same size, and all corresponding pairs of elements in
+ * the two lists are <i>equal</i>.  (Two elements <tt>e1</tt> and
+ * <tt>e2</tt> are <i>equal</i> if <tt>(e1==null ? e2==null :
+ * e1.equals(e2))</tt>.)  In other words, two lists are defined to be
+ * equal if they contain the same elements in the same order.  This
+ * definition ensures that the equals method works properly across
+ * different implementations of the <tt>List</tt> int64_terface.
+ *
+ * @param o the object to be compared for equality with this list
+ * @return <tt>true</tt> if the specified object is equal to this list
+ */
+bool list_equals(list_List list, list_List o) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	ArrayDeque* deque2 = (ArrayDeque*) o;
+	if (deque->size != deque2->size)
+		return false;
+	for (int64_t i = 0; i < deque->size; ++i)
+		if (*elementAt(deque, i) != *elementAt(deque2, i))
+			return false;
+	return true;
+}
+
+
+
+// Positional Access Operations
+
+/**
+ * Returns the element at the specified position in this list.
+ *
+ * @param index index of the element to return
+ * @return the element at the specified position in this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_get(list_List list, int64_t index) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(index >= 0 && index < deque->size);
+	return *elementAt(deque, index);
+}
+
+/**
+ * Replaces the element at the specified position in this list with the
+ * specified element (optional operation).
+ *
+ * @param index index of the element to replace
+ * @param element element to be stored at the specified position
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>set</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_set(list_List list, int64_t index, void* element) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(index >= 0 && index < deque->size);
+	void** slot = elementAt(deque, index);
+	void* result = *slot;
+	*slot = element;
+	return result;
+}
+
+/**
+ * Inserts the specified element at the specified position in this list
+ * (optional operation).  Shifts the element currently at that position
+ * (if any) and any subsequent elements to the right (adds one to their
+ * indices).
+ *
+ * @param index index at which the specified element is to be inserted
+ * @param element element to be inserted
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+void list_addAt(list_List list, int64_t index, void* element) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(index >= 0 && index <= deque->size);
+	openGap(deque, index, 1);
+	*elementAt(deque, index) = element;
+}
+
+/**
+ * Removes the element at the specified position in this list (optional
+ * operation).  Shifts any subsequent elements to the left (subtracts one
+ * from their indices).  Returns the element that was removed from the
+ * list.
+ *
+ * @param index the index of the element to be removed
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_removeAt(list_List list, int64_t index) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(index >= 0 && index < deque->size);
+	void* result = *elementAt(deque, index);
+	closeGap(deque, index, index + 1);
+	return result;
+}
+
+/**
+ * Removes from this deque all of the elements whose index is between
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  The
+ * elements on the shorter side of the removed range are the ones moved.
+ *
+ * @param fromIndex index of first element to be removed
+ * @param toIndex index after last element to be removed
+ * @throws IndexOutOfBoundsException if <tt>fromIndex</tt> or
+ * <tt>toIndex</tt> is out of range
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size() || toIndex &lt; fromIndex</tt>)
+ */
+void list_removeRange(list_List list, int64_t fromIndex, int64_t toIndex) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(fromIndex >= 0 && toIndex <= deque->size && toIndex >= fromIndex);
+	closeGap(deque, fromIndex, toIndex);
+}
+
+
+
+// Deque Operations
+
+/**
+ * Inserts the specified element at the front of this deque.
+ *
+ * @param e the element to add
+ */
+void list_addFirst(list_List list, void* e) {
+	list_addAt(list, 0, e);
+}
+
+/**
+ * Inserts the specified element at the end of this deque.  This method
+ * is equivalent to {@link #add}.
+ *
+ * @param e the element to add
+ */
+void list_addLast(list_List list, void* e) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	list_addAt(list, deque->size, e);
+}
+
+/**
+ * Retrieves and removes the first element of this deque, or returns
+ * <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the head of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_pollFirst(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	if (deque->size == 0)
+		return NULL;
+	return list_removeAt(list, 0);
+}
+
+/**
+ * Retrieves and removes the last element of this deque, or returns
+ * <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the tail of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_pollLast(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	if (deque->size == 0)
+		return NULL;
+	return list_removeAt(list, deque->size - 1);
+}
+
+/**
+ * Retrieves, but does not remove, the first element of this deque, or
+ * returns <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the head of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_peekFirst(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	if (deque->size == 0)
+		return NULL;
+	return *elementAt(deque, 0);
+}
+
+/**
+ * Retrieves, but does not remove, the last element of this deque, or
+ * returns <tt>NULL</tt> if this deque is empty.
+ *
+ * @return the tail of this deque, or <tt>NULL</tt> if this deque is empty
+ */
+void* list_peekLast(list_List list) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	if (deque->size == 0)
+		return NULL;
+	return *elementAt(deque, deque->size - 1);
+}
+
+
+
+// Search Operations
+
+/**
+ * Returns the index of the first occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the first occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_indexOf(list_List list, void* o) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	void** span[2];
+	int64_t spanLength[2];
+	int count = spans(deque, 0, deque->size, span, spanLength);
+	int64_t base = 0;
+	for (int s = 0; s < count; ++s) {
+		for (int64_t i = 0; i < spanLength[s]; ++i)
+			if (span[s][i] == o)
+				return base + i;
+		base += spanLength[s];
+	}
+	return -1;
+}
+
+/**
+ * Returns the index of the last occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the highest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the last occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_lastIndexOf(list_List list, void* o) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	void** span[2];
+	int64_t spanLength[2];
+	int count = spans(deque, 0, deque->size, span, spanLength);
+	int64_t base = deque->size;
+	for (int s = count - 1; s >= 0; --s) {
+		base -= spanLength[s];
+		for (int64_t i = spanLength[s] - 1; i >= 0; --i)
+			if (span[s][i] == o)
+				return base + i;
+	}
+	return -1;
+}
+
+
+
+// Iteration
+
+/**
+ * Calls <tt>action</tt> on each element of this list in order, until it
+ * returns <tt>false</tt>.  Nothing is allocated or copied.  The behavior
+ * is undefined if the list is structurally modified by the action.
+ *
+ * @param action the function called on each element
+ * @param context passed through to every call of <tt>action</tt>
+ * @return <tt>true</tt> if every element was visited
+ */
+bool list_forEach(list_List list, list_Consumer action, void* context) {
+	int64_t position = 0;
+	void* const* data;
+	size_t length;
+	while ((length = list_nextSpan(list, &position, &data)) > 0)
+		for (size_t i = 0; i < length; ++i)
+			if (!action(data[i], context))
+				return false;
+	return true;
+}
+
+/**
+ * Advances a cursor over the elements of this list one contiguous span of
+ * the backing storage at a time.  Start with <tt>*position</tt> set to 0
+ * and call repeatedly; each call points <tt>*data</tt> at the next run of
+ * consecutive elements, in list order, and advances <tt>*position</tt>
+ * past it.  For a view the spans cover only the view.  The slots must not
+ * be written through <tt>*data</tt>, and the behavior is undefined if the
+ * list is structurally modified during the iteration.  Nothing is
+ * allocated or copied.
+ *
+ * @param position index of the next element to return, 0 to start
+ * @param data receives the address of the first element of the span
+ * @return the number of elements in the span, 0 once the end of the list
+ * is reached
+ */
+size_t list_nextSpan(list_List list, int64_t* position, void* const** data) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(*position >= 0 && *position <= deque->size);
+	void** span[2];
+	int64_t spanLength[2];
+	if (spans(deque, *position, deque->size - *position, span, spanLength) == 0)
+		return 0;
+	*data = span[0];
+	*position += spanLength[0];
+	return spanLength[0];
+}
+
+
+
+// View
+
+/**
+ * Returns a view of the portion of this list between the specified
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  (If
+ * <tt>fromIndex</tt> and <tt>toIndex</tt> are equal, the returned list is
+ * empty.)  The returned list is backed by this list, so non-structural
+ * changes in the returned list are reflected in this list, and vice-versa.
+ * The returned list supports all of the optional list operations supported
+ * by this list.<p>
+ *
+ * This method eliminates the need for explicit range operations (of
+ * the sort that commonly exist for arrays).  Any operation that expects
+ * a list can be used as a range operation by passing a subList view
+ * instead of a whole list.  For example, the following idiom
+ * removes a range of elements from a list:
+ * <pre>
+ *  list.subList(from, to).clear();
+ * </pre>
+ * Similar idioms may be constructed for <tt>indexOf</tt> and
+ * <tt>lastIndexOf</tt>, and all of the algorithms in the
+ * <tt>Collections</tt> class can be applied to a subList.<p>
+ *
+ * The semantics of the list returned by this method become undefined if
+ * the backing list (i.e., this list) is <i>structurally modified</i> in
+ * any way other than via the returned list.  (Structural modifications are
+ * those that change the size of this list, or otherwise perturb it in such
+ * a fashion that iterations in progress may yield incorrect results.)
+ *
+ * @param fromIndex low endpoint64_t (inclusive) of the subList
+ * @param toIndex high endpoint64_t (exclusive) of the subList
+ * @return a view of the specified range within this list
+ * @throws IndexOutOfBoundsException for an illegal endpoint64_t index value
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size ||
+ * fromIndex &gt; toIndex</tt>)
+ */
+list_List list_subList(list_List list, int64_t fromIndex, int64_t toIndex) {
+	ArrayDeque* deque = (ArrayDeque*) list;
+	assert(fromIndex >= 0 && toIndex <= deque->size && toIndex >= fromIndex);
+	const collection_Allocator* allocator = deque->allocator;
+	ArrayDeque* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(ArrayDeque));
+	assert(result != NULL);
+	memset(result, 0, sizeof(ArrayDeque));
+	result->size = toIndex - fromIndex;
+	result->offset = deque->offset + fromIndex;
+	result->superList = deque;
+	result->root = deque->root;
+	result->allocator = allocator;
+	return (list_List) result;
+}
@@ -27,36 +27,882 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
+#if defined(__x86_64__) && defined(__GNUC__) && UINTPTR_MAX == UINT64_MAX
+#define SIMD_SEARCH
+#include <immintrin.h>
+#endif
+
+#include "collection/allocator.h"
+
+#ifdef ARRAYLIST_SHARED_READS
+#define LIST_IMPLEMENTATION syncarray
+#else
 #define LIST_IMPLEMENTATION array
+#endif
 #include "collection/list/implementations/arraylist.h"
+#include "collection/list/implementations/arraylistlayout.h"
+#include "multiset.h"
 
 #define INIT_MAX_SIZE 10
-#define REALLOC_INTERVAL 10
+#define GROWTH_FACTOR 1.5
 
-typedef struct {
-	void** array;
-	int64_t size;
-	int64_t maxSize;
-	list_List superList;
-} ArrayList;
+// number of elements kept inside the header of lists made by newSmallList
+#ifndef LIST_INLINE_CAPACITY
+#define LIST_INLINE_CAPACITY 4
+#endif
+
+/*
+ * With -DCOLLECTION_STATS every list counts its operations, reallocations,
+ * shifted elements and comparisons, and is linked into the list of live
+ * lists of its creation site.  Without it STATS drops its argument and
+ * COMPARE is a plain comparator call, so the counters cost nothing.
+ * Comparator calls are counted per thread and collected by the operation
+ * that made them.
+ */
+#ifdef COLLECTION_STATS
+#define STATS(statement) statement
+#define COMPARE(c, a, b) (++threadComparisons, (c)((a), (b)))
+static _Thread_local uint64_t threadComparisons;
+#else
+#define STATS(statement)
+#define COMPARE(c, a, b) (c)((a), (b))
+#endif
+
+/*
+ * With -DARRAYLIST_SHARED_READS this file builds the syncarray_list_*
+ * functions used by the SynchronizedList (see syncarraylist.c), whose
+ * readers load the array, the size and the slots of a list with atomic
+ * loads while a writer modifies it.  The writer's stores to those words
+ * are then atomic too, so the two never race: the array is published with
+ * release semantics, so that a reader seeing a new array also sees the
+ * elements copied into it, and elements are moved and copied one slot at
+ * a time.  Only the operations the SynchronizedList calls are covered.
+ * Otherwise the macros below are plain stores, memmove, memcpy and memset.
+ */
+#ifdef ARRAYLIST_SHARED_READS
+#define SET_ARRAY(arrList, value) __atomic_store_n(&(arrList)->array, (value), __ATOMIC_RELEASE)
+#define SET_SIZE(arrList, value) __atomic_store_n(&(arrList)->size, (value), __ATOMIC_RELAXED)
+#define SET_SLOT(slot, value) __atomic_store_n(&(slot), (value), __ATOMIC_RELAXED)
+
+static void moveSlots(void** to, void** from, int64_t count) {
+	if (to < from)
+		for (int64_t i = 0; i < count; ++i)
+			SET_SLOT(to[i], from[i]);
+	else
+		for (int64_t i = count - 1; i >= 0; --i)
+			SET_SLOT(to[i], from[i]);
+}
+
+#define copySlots(to, from, count) moveSlots((to), (from), (count))
+
+static void clearSlots(void** to, int64_t count) {
+	for (int64_t i = 0; i < count; ++i)
+		SET_SLOT(to[i], NULL);
+}
+#else
+#define SET_ARRAY(arrList, value) ((arrList)->array = (value))
+#define SET_SIZE(arrList, value) ((arrList)->size = (value))
+#define SET_SLOT(slot, value) ((slot) = (value))
+#define moveSlots(to, from, count) memmove((to), (from), sizeof(void*) * (count))
+#define copySlots(to, from, count) memcpy((to), (from), sizeof(void*) * (count))
+#define clearSlots(to, count) memset((to), 0, sizeof(void*) * (count))
+#endif
+
+typedef array_list_Layout ArrayList;
+
+#ifndef ARRAYLIST_SHARED_READS
+// referenced by code built with the inline accessors of arraylist.h
+const int ARRAYLIST_LAYOUT_SYMBOL(ARRAYLIST_LAYOUT_VERSION) = ARRAYLIST_LAYOUT_VERSION;
+#endif
+
+static size_t headerSize(ArrayList* arrList) {
+	if (arrList->hasInlineStorage)
+		return sizeof(ArrayList) + sizeof(void*) * LIST_INLINE_CAPACITY;
+	return sizeof(ArrayList);
+}
+
+static bool usesInlineStorage(ArrayList* arrList) {
+	return arrList->hasInlineStorage && arrList->array == arrList->inlineArray;
+}
+
+/*
+ * A subList is a view holding an offset into the root list, which owns the
+ * array.  Structural changes made through a view are applied to the root
+ * with one block move and reflected in the sizes of the view and its
+ * enclosing views.  The root counts its structural changes, sorts
+ * included, in modCount and a view remembers the count it last saw, so a
+ * view used after its root was structurally modified by other means fails
+ * an assertion.  The root also counts the calls of set and sort made
+ * through it or any of its views in orderCount; a view that sees the count
+ * move forgets its comparator, since its elements may have been replaced
+ * or reordered.
+ *
+ * Returns the list behind list.  For a view, first checks that it is not
+ * stale and points its array at the current array of the root, which may
+ * have been reallocated since.  Every operation starts here.
+ */
+static inline ArrayList* syncView(list_List list) {
+	ArrayList* arrList = (ArrayList*) list;
+	if (arrList->superList != NULL) {
+		ArrayList* root = arrList->root;
+		assert(arrList->modCount == root->modCount && "list structurally modified outside this view");
+		arrList->array = root->array + arrList->offset;
+		if (arrList->orderCount != root->orderCount) {
+			arrList->comparator = NULL;
+			arrList->orderCount = root->orderCount;
+		}
+	}
+	return arrList;
+}
+
+// number of elements the list can hold before the array of its root grows
+static int64_t capacityOf(ArrayList* arrList) {
+	ArrayList* root = arrList->root;
+	return root->maxSize - root->size + arrList->size;
+}
+
+
+
+// Statistics Registry
+
+#ifdef COLLECTION_STATS
+/*
+ * A creation site keeps the counters of its deleted lists in retired and
+ * links its live lists, whose counters are added in when they are dumped.
+ * Sites are never freed.
+ */
+typedef struct array_list_Site {
+	const char* file;
+	int line;
+	int64_t lists;
+	list_Stats retired;
+	ArrayList* live;
+	struct array_list_Site* next;
+} Site;
+
+static pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER;
+static Site untaggedSite;
+static Site* sites = &untaggedSite;
+
+static uint64_t takeComparisons() {
+	uint64_t n = threadComparisons;
+	threadComparisons = 0;
+	return n;
+}
+
+/*
+ * Adds the comparator calls made so far by this thread and the elements a
+ * search examined to the comparisons of the list.
+ */
+static void countComparisons(ArrayList* arrList, int64_t examined) {
+	arrList->stats.comparisons += takeComparisons() + examined;
+}
+
+static void countPeak(ArrayList* arrList) {
+	if (arrList->size > arrList->stats.peakSize)
+		arrList->stats.peakSize = arrList->size;
+}
+
+static void mergeStats(list_Stats* into, const list_Stats* from) {
+	for (int op = 0; op < LIST_STATS_OPERATIONS; ++op)
+		into->calls[op] += from->calls[op];
+	into->reallocs += from->reallocs;
+	into->elementsShifted += from->elementsShifted;
+	into->comparisons += from->comparisons;
+	into->slack += from->slack;
+	if (from->peakSize > into->peakSize)
+		into->peakSize = from->peakSize;
+}
+
+// callers hold statsLock
+static void linkAtSite(ArrayList* arrList, Site* site) {
+	arrList->site = site;
+	arrList->previousAtSite = NULL;
+	arrList->nextAtSite = site->live;
+	if (site->live != NULL)
+		site->live->previousAtSite = arrList;
+	site->live = arrList;
+}
+
+// callers hold statsLock
+static void unlinkAtSite(ArrayList* arrList) {
+	Site* site = arrList->site;
+	if (arrList->previousAtSite != NULL)
+		arrList->previousAtSite->nextAtSite = arrList->nextAtSite;
+	else
+		site->live = arrList->nextAtSite;
+	if (arrList->nextAtSite != NULL)
+		arrList->nextAtSite->previousAtSite = arrList->previousAtSite;
+}
+
+/*
+ * Starts counting for a new list created at the given site.
+ */
+static void registerList(ArrayList* arrList, Site* site) {
+	memset(&arrList->stats, 0, sizeof(arrList->stats));
+	arrList->stats.peakSize = arrList->size;
+	pthread_mutex_lock(&statsLock);
+	++site->lists;
+	linkAtSite(arrList, site);
+	pthread_mutex_unlock(&statsLock);
+}
+
+/*
+ * Makes a list count towards another site, counters included.
+ */
+static void moveToSite(ArrayList* arrList, Site* site) {
+	pthread_mutex_lock(&statsLock);
+	if (arrList->site != site) {
+		unlinkAtSite(arrList);
+		--arrList->site->lists;
+		++site->lists;
+		linkAtSite(arrList, site);
+	}
+	pthread_mutex_unlock(&statsLock);
+}
+
+/*
+ * Moves the counters of a list being deleted to its site.
+ */
+static void unregisterList(ArrayList* arrList) {
+	pthread_mutex_lock(&statsLock);
+	unlinkAtSite(arrList);
+	mergeStats(&arrList->site->retired, &arrList->stats);
+	pthread_mutex_unlock(&statsLock);
+}
+#endif
+
+/*
+ * Drops this list's reference to its shared array.  Returns true if it was
+ * the last one, in which case the caller now owns the array.
+ */
+static bool releaseShare(ArrayList* arrList) {
+	const collection_Allocator* allocator = arrList->allocator;
+	_Atomic int64_t* shareCount = arrList->shareCount;
+	arrList->shareCount = NULL;
+	if (atomic_fetch_sub_explicit(shareCount, 1, memory_order_acq_rel) > 1)
+		return false;
+	allocator->deallocate(allocator->context, shareCount, sizeof(_Atomic int64_t));
+	return true;
+}
+
+/*
+ * Releases the backing array unless it is borrowed from a super list,
+ * lives inside the header or is still shared with a snapshot.
+ */
+static void freeArray(ArrayList* arrList) {
+	const collection_Allocator* allocator = arrList->allocator;
+	if (arrList->superList != NULL || usesInlineStorage(arrList))
+		return;
+	if (arrList->shareCount != NULL && !releaseShare(arrList))
+		return;
+	allocator->deallocate(allocator->context, arrList->array,
+			sizeof(void*) * arrList->maxSize);
+}
+
+/*
+ * Makes sure the backing array can be written, giving the root list a
+ * private copy of its first keep elements if the array is shared with a
+ * snapshot.  A view keeps every element of its root.  Every modification
+ * goes through here first.
+ */
+static void unshare(ArrayList* arrList, int64_t keep) {
+	ArrayList* root = arrList->root;
+	const collection_Allocator* allocator = root->allocator;
+	assert(!arrList->readOnly);
+	if (root->shareCount == NULL)
+		return;
+	if (atomic_load_explicit(root->shareCount, memory_order_acquire) == 1) {
+		// every snapshot is gone, the array is ours again
+		releaseShare(root);
+		return;
+	}
+	if (root != arrList)
+		keep = root->size;
+	void** temp = allocator->allocate(allocator->context, sizeof(void*) * root->maxSize);
+	assert(temp != NULL);
+	memcpy(temp, root->array, sizeof(void*) * keep);
+	if (releaseShare(root))
+		allocator->deallocate(allocator->context, root->array,
+				sizeof(void*) * root->maxSize);
+	SET_ARRAY(root, temp);
+	SET_ARRAY(arrList, temp + arrList->offset);
+	STATS(++arrList->stats.reallocs);
+}
 
 list_List list_newList() {
+	return list_newListWithAllocator(&collection_stdAllocator);
+}
+
+list_List list_newListWithAllocator(const collection_Allocator* allocator) {
 	ArrayList* result = NULL;
-	result = calloc(1, sizeof(ArrayList));
+	result = allocator->allocate(allocator->context, sizeof(ArrayList));
 	assert(result != NULL);
-	result->array = calloc(INIT_MAX_SIZE, sizeof(void*));
+	memset(result, 0, sizeof(ArrayList));
+	result->array = allocator->allocate(allocator->context, sizeof(void*) * INIT_MAX_SIZE);
 	assert(result->array != NULL);
 	result->maxSize = INIT_MAX_SIZE;
+	result->root = result;
+	result->growthFactor = GROWTH_FACTOR;
+	result->growthIncrement = 0;
+	result->allocator = allocator;
+	STATS(registerList(result, &untaggedSite));
+	return (list_List) result;
+}
+
+list_List list_newSmallList() {
+	return list_newSmallListWithAllocator(&collection_stdAllocator);
+}
+
+list_List list_newSmallListWithAllocator(const collection_Allocator* allocator) {
+	size_t size = sizeof(ArrayList) + sizeof(void*) * LIST_INLINE_CAPACITY;
+	ArrayList* result = NULL;
+	result = allocator->allocate(allocator->context, size);
+	assert(result != NULL);
+	memset(result, 0, size);
+	result->array = result->inlineArray;
+	result->maxSize = LIST_INLINE_CAPACITY;
+	result->root = result;
+	result->growthFactor = GROWTH_FACTOR;
+	result->growthIncrement = 0;
+	result->allocator = allocator;
+	result->hasInlineStorage = true;
+	STATS(registerList(result, &untaggedSite));
+	return (list_List) result;
+}
+
+/**
+ * Constructs a list that takes ownership of <tt>array</tt> instead of
+ * copying it.  The first <tt>size</tt> slots of the array become the
+ * elements of the list, and the list may fill the remaining slots up to
+ * <tt>capacity</tt> before it has to reallocate.  The array must have been
+ * obtained from <tt>malloc</tt> or <tt>realloc</tt>; the list frees it
+ * when it is deleted.  The caller must not use the array afterwards.
+ *
+ * @param array heap array of at least <tt>capacity</tt> slots, or
+ * <tt>NULL</tt> if <tt>capacity</tt> is 0
+ * @param size number of elements in the array
+ * @param capacity number of slots in the array, at least <tt>size</tt>
+ * @return the new list
+ */
+list_List list_fromArray(void** array, int64_t size, int64_t capacity) {
+	return list_fromArrayWithAllocator(&collection_stdAllocator, array, size, capacity);
+}
+
+/**
+ * Constructs a list that takes ownership of <tt>array</tt>, as by
+ * {@link #fromArray}, where the array was obtained from
+ * <tt>allocator</tt> with room for <tt>capacity</tt> elements.
+ *
+ * @param allocator allocator that must outlive the list
+ * @param array array of at least <tt>capacity</tt> slots, or <tt>NULL</tt>
+ * if <tt>capacity</tt> is 0
+ * @param size number of elements in the array
+ * @param capacity number of slots in the array, at least <tt>size</tt>
+ * @return the new list
+ */
+list_List list_fromArrayWithAllocator(const collection_Allocator* allocator,
+		void** array, int64_t size, int64_t capacity) {
+	assert(size >= 0 && capacity >= size);
+	assert(array != NULL || capacity == 0);
+	ArrayList* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(ArrayList));
+	assert(result != NULL);
+	memset(result, 0, sizeof(ArrayList));
+	result->array = array;
+	result->size = size;
+	result->maxSize = capacity;
+	result->root = result;
+	result->growthFactor = GROWTH_FACTOR;
+	result->growthIncrement = 0;
+	result->allocator = allocator;
+	STATS(registerList(result, &untaggedSite));
 	return (list_List) result;
 }
 
 bool list_delList(list_List list) {
 	ArrayList* arrList = (ArrayList*) list;
-	if (arrList->superList == NULL)
-		free(arrList->array);
-	free(arrList);
+	const collection_Allocator* allocator = arrList->allocator;
+	STATS(unregisterList(arrList));
+	freeArray(arrList);
+	allocator->deallocate(allocator->context, arrList, headerSize(arrList));
+	return true;
+}
+
+
+
+// Capacity Operations
+
+static void resizeArray(ArrayList* arrList, int64_t newMaxSize) {
+	const collection_Allocator* allocator = arrList->allocator;
+	void** temp;
+	if (usesInlineStorage(arrList)) {
+		// spill the inline elements to the heap
+		temp = allocator->allocate(allocator->context, sizeof(void*) * newMaxSize);
+		assert(temp != NULL);
+		memcpy(temp, arrList->array, sizeof(void*) * arrList->size);
+	} else {
+		temp = allocator->reallocate(allocator->context, arrList->array,
+				sizeof(void*) * arrList->maxSize, sizeof(void*) * newMaxSize);
+		assert(temp != NULL);
+	}
+	SET_ARRAY(arrList, temp);
+	arrList->maxSize = newMaxSize;
+	STATS(++arrList->stats.reallocs);
+}
+
+/*
+ * Moves count elements starting at index from so that they start at index
+ * to.  The ranges may overlap.  Every structural shift of the backing array
+ * goes through here so that it costs one memmove instead of an element by
+ * element loop.
+ */
+static void moveBlock(ArrayList* arrList, int64_t from, int64_t to, int64_t count) {
+	if (count > 0 && from != to) {
+		moveSlots(arrList->array + to, arrList->array + from, count);
+		STATS(arrList->stats.elementsShifted += count);
+	}
+}
+
+/*
+ * Grows the backing array so it can hold at least minSize elements.  The
+ * new capacity follows the list's growth policy, so a series of appends
+ * costs amortized O(1) per element when the growth factor is above 1.
+ */
+static void bulkUpdateSize(ArrayList* arrList, int64_t minSize) {
+	if (minSize <= arrList->maxSize)
+		return;
+	int64_t newMaxSize = (int64_t) (arrList->maxSize * arrList->growthFactor)
+			+ arrList->growthIncrement;
+	if (newMaxSize < minSize)
+		newMaxSize = minSize;
+	resizeArray(arrList, newMaxSize);
+}
+
+/*
+ * Forgets that the list is sorted, along with every list it is a view of.
+ */
+static void clearSorted(ArrayList* arrList) {
+	for (; arrList != NULL; arrList = (ArrayList*) arrList->superList)
+		arrList->comparator = NULL;
+}
+
+/*
+ * Records a structural change made through arrList, so that the views of
+ * the root other than arrList and the lists it is a view of become stale.
+ */
+static void recordModification(ArrayList* arrList) {
+	ArrayList* root = arrList->root;
+	++root->modCount;
+	for (ArrayList* view = arrList; view != root; view = (ArrayList*) view->superList)
+		view->modCount = root->modCount;
+}
+
+/*
+ * Records that elements were replaced or reordered through arrList, so
+ * that the other views of the root forget their comparator.
+ */
+static void recordReorder(ArrayList* arrList) {
+	ArrayList* root = arrList->root;
+	++root->orderCount;
+	arrList->orderCount = root->orderCount;
+}
+
+/*
+ * Adds delta to the size of arrList, of every list it is a view of and of
+ * the root, and records the structural change.
+ */
+static void adjustSizes(ArrayList* arrList, int64_t delta) {
+	ArrayList* root = arrList->root;
+	recordModification(arrList);
+	for (ArrayList* view = arrList; view != root; view = (ArrayList*) view->superList)
+		SET_SIZE(view, view->size + delta);
+	SET_SIZE(root, root->size + delta);
+}
+
+/*
+ * Makes room for n elements before position index of arrList, growing the
+ * array of the root if needed and shifting the rest of the root with one
+ * block move.  The new slots are left uninitialized.  An insertion into a
+ * view may break the order of the lists it is a view of, so they forget
+ * their comparator.
+ */
+static void openGap(ArrayList* arrList, int64_t index, int64_t n) {
+	ArrayList* root = arrList->root;
+	if (n == 0)
+		return;
+	bulkUpdateSize(root, root->size + n);
+	SET_ARRAY(arrList, root->array + arrList->offset);
+	moveBlock(arrList, index, index + n, root->size - arrList->offset - index);
+	adjustSizes(arrList, n);
+	if (arrList->superList != NULL)
+		clearSorted((ArrayList*) arrList->superList);
+}
+
+/*
+ * Removes the elements [from, to) of arrList, shifting the rest of the root
+ * with one block move.
+ */
+static void closeGap(ArrayList* arrList, int64_t from, int64_t to) {
+	ArrayList* root = arrList->root;
+	if (from == to)
+		return;
+	moveBlock(arrList, to, from, root->size - arrList->offset - to);
+	adjustSizes(arrList, from - to);
+}
+
+/**
+ * Sets the policy used to grow the backing array when it runs out of
+ * room.  The new capacity is <tt>capacity * factor + increment</tt>, or
+ * the required size if that is larger.  A factor of <tt>1.0</tt> with a
+ * non-zero increment gives linear growth (the historic behavior used a
+ * fixed increment of 10); a factor above <tt>1.0</tt> gives geometric
+ * growth and amortized constant-time appends.  The policy of a view is
+ * that of the list owning the array.
+ *
+ * @param factor multiplier applied to the current capacity, at least 1.0
+ * @param increment number of slots added after scaling, at least 0
+ */
+void list_setGrowthPolicy(list_List list, double factor, int64_t increment) {
+	ArrayList* root = syncView(list)->root;
+	assert(factor >= 1.0 && increment >= 0);
+	assert(factor > 1.0 || increment > 0);
+	root->growthFactor = factor;
+	root->growthIncrement = increment;
+}
+
+/**
+ * Returns the number of elements this list can hold before its backing
+ * array has to be reallocated.  For a view, the elements of the rest of
+ * the list it is a view of are taken into account.
+ *
+ * @return the capacity of this list
+ */
+int64_t list_capacity(list_List list) {
+	ArrayList* arrList = syncView(list);
+	return capacityOf(arrList);
+}
+
+/**
+ * Increases the capacity of this list, if necessary, so that it can hold
+ * at least the number of elements specified by the minimum capacity
+ * argument without reallocating.
+ *
+ * @param minCapacity the desired minimum capacity
+ */
+void list_reserve(list_List list, int64_t minCapacity) {
+	ArrayList* arrList = syncView(list);
+	ArrayList* root = arrList->root;
+	assert(minCapacity >= 0);
+	unshare(arrList, arrList->size);
+	if (minCapacity > capacityOf(arrList))
+		resizeArray(root, root->size - arrList->size + minCapacity);
+}
+
+/**
+ * Trims the capacity of this list to be the list's current size.  An
+ * application can use this operation to hand back the slack left over
+ * after a bulk load.  On a view, trims the list owning the array.
+ */
+void list_shrinkToFit(list_List list) {
+	ArrayList* arrList = syncView(list)->root;
+	unshare(arrList, arrList->size);
+	if (arrList->size == arrList->maxSize || usesInlineStorage(arrList))
+		return;
+	if (arrList->hasInlineStorage && arrList->size <= LIST_INLINE_CAPACITY) {
+		// move back into the header
+		memcpy(arrList->inlineArray, arrList->array, sizeof(void*) * arrList->size);
+		freeArray(arrList);
+		arrList->array = arrList->inlineArray;
+		arrList->maxSize = LIST_INLINE_CAPACITY;
+	} else if (arrList->size == 0) {
+		freeArray(arrList);
+		arrList->array = NULL;
+		arrList->maxSize = 0;
+	} else
+		resizeArray(arrList, arrList->size);
+}
+
+/**
+ * Hands the backing array of this list over to the caller and leaves the
+ * list empty, with no backing array.  The elements are not copied unless
+ * they are kept inside the list header (see {@link #newSmallList}) or
+ * the list is a view of another list, in which case they are copied into
+ * a new array of exactly <tt>size</tt> slots and the view is cleared, or
+ * the array is shared with a snapshot (see {@link #snapshot}), in which
+ * case the list first takes a private copy.
+ * The array is owned by the caller from then on and must be released
+ * with the list's allocator (<tt>free</tt> for lists that were not given
+ * one), or passed to {@link #fromArray} to make it a list again.
+ *
+ * @param size receives the number of elements in the returned array
+ * @param capacity receives the number of slots in the returned array, if
+ * not <tt>NULL</tt>
+ * @return the former backing array of this list, or <tt>NULL</tt> if it
+ * had none
+ */
+void** list_detachArray(list_List list, int64_t* size, int64_t* capacity) {
+	ArrayList* arrList = syncView(list);
+	const collection_Allocator* allocator = arrList->allocator;
+	void** result;
+	int64_t resultSize = arrList->size;
+	int64_t resultCapacity;
+	unshare(arrList, arrList->size);
+	if (arrList->superList != NULL || usesInlineStorage(arrList)) {
+		// the array is not ours to give away, hand out a copy
+		resultCapacity = resultSize;
+		result = NULL;
+		if (resultCapacity > 0) {
+			result = allocator->allocate(allocator->context, sizeof(void*) * resultCapacity);
+			assert(result != NULL);
+			memcpy(result, arrList->array, sizeof(void*) * resultSize);
+		}
+		closeGap(arrList, 0, resultSize);
+	} else {
+		result = arrList->array;
+		resultCapacity = arrList->maxSize;
+		adjustSizes(arrList, -resultSize);
+		arrList->array = NULL;
+		arrList->maxSize = 0;
+	}
+	*size = resultSize;
+	if (capacity != NULL)
+		*capacity = resultCapacity;
+	return result;
+}
+
+
+
+// Search Kernels
+
+/*
+ * Pointer search kernels used by contains, indexOf, lastIndexOf and
+ * remove.  Each returns the index of the first (or last) slot of
+ * array[0, size) equal to o, or -1.  The vector variants compare 2, 4 or 8
+ * pointers per instruction; the best one the CPU supports is picked once
+ * at load time and the scalar loop is used everywhere else.
+ */
+typedef list_SearchKernel SearchKernel;
+
+static int64_t scalarIndexOf(void** array, int64_t size, void* o) {
+	for (int64_t i = 0; i < size; ++i)
+		if (array[i] == o)
+			return i;
+	return -1;
+}
+
+static int64_t scalarLastIndexOf(void** array, int64_t size, void* o) {
+	for (int64_t i = size - 1; i >= 0; --i)
+		if (array[i] == o)
+			return i;
+	return -1;
+}
+
+#ifdef SIMD_SEARCH
+
+/*
+ * SSE2 has no 64 bit compare, so two 32 bit halves are compared and the
+ * result is ANDed with itself swapped within each 64 bit lane.
+ */
+static inline int sse2Match(void** at, __m128i key) {
+	__m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) at), key);
+	eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+static int64_t sse2IndexOf(void** array, int64_t size, void* o) {
+	__m128i key = _mm_set1_epi64x((int64_t) (uintptr_t) o);
+	int64_t i = 0;
+	for (; i + 2 <= size; i += 2) {
+		int mask = sse2Match(array + i, key);
+		if (mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+	int64_t j = scalarIndexOf(array + i, size - i, o);
+	return j < 0 ? -1 : i + j;
+}
+
+static int64_t sse2LastIndexOf(void** array, int64_t size, void* o) {
+	__m128i key = _mm_set1_epi64x((int64_t) (uintptr_t) o);
+	int64_t i = size;
+	for (; i >= 2; i -= 2) {
+		int mask = sse2Match(array + i - 2, key);
+		if (mask != 0)
+			return i - 2 + 31 - __builtin_clz(mask);
+	}
+	return scalarLastIndexOf(array, i, o);
+}
+
+__attribute__((target("avx2")))
+static int64_t avx2IndexOf(void** array, int64_t size, void* o) {
+	__m256i key = _mm256_set1_epi64x((int64_t) (uintptr_t) o);
+	int64_t i = 0;
+	for (; i + 4 <= size; i += 4) {
+		__m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*) (array + i)), key);
+		int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+		if (mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+	int64_t j = scalarIndexOf(array + i, size - i, o);
+	return j < 0 ? -1 : i + j;
+}
+
+__attribute__((target("avx2")))
+static int64_t avx2LastIndexOf(void** array, int64_t size, void* o) {
+	__m256i key = _mm256_set1_epi64x((int64_t) (uintptr_t) o);
+	int64_t i = size;
+	for (; i >= 4; i -= 4) {
+		__m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*) (array + i - 4)), key);
+		int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+		if (mask != 0)
+			return i - 4 + 31 - __builtin_clz(mask);
+	}
+	return scalarLastIndexOf(array, i, o);
+}
+
+__attribute__((target("avx512f")))
+static int64_t avx512IndexOf(void** array, int64_t size, void* o) {
+	__m512i key = _mm512_set1_epi64((int64_t) (uintptr_t) o);
+	int64_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		__mmask8 mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(array + i), key);
+		if (mask != 0)
+			return i + __builtin_ctz(mask);
+	}
+	int64_t j = scalarIndexOf(array + i, size - i, o);
+	return j < 0 ? -1 : i + j;
+}
+
+__attribute__((target("avx512f")))
+static int64_t avx512LastIndexOf(void** array, int64_t size, void* o) {
+	__m512i key = _mm512_set1_epi64((int64_t) (uintptr_t) o);
+	int64_t i = size;
+	for (; i >= 8; i -= 8) {
+		__mmask8 mask = _mm512_cmpeq_epi64_mask(_mm512_loadu_si512(array + i - 8), key);
+		if (mask != 0)
+			return i - 8 + 31 - __builtin_clz(mask);
+	}
+	return scalarLastIndexOf(array, i, o);
+}
+
+#endif
+
+/*
+ * Every kernel, each one needing a superset of the instructions of the one
+ * before, so the kernels the CPU supports are a prefix of the table.
+ */
+static const list_SearchKernels searchKernels[] = {
+	{ "scalar", scalarIndexOf, scalarLastIndexOf },
+#ifdef SIMD_SEARCH
+	{ "sse2", sse2IndexOf, sse2LastIndexOf },
+	{ "avx2", avx2IndexOf, avx2LastIndexOf },
+	{ "avx512f", avx512IndexOf, avx512LastIndexOf },
+#endif
+};
+
+static size_t supportedSearchKernels = 1;
+static SearchKernel indexOfKernel = scalarIndexOf;
+static SearchKernel lastIndexOfKernel = scalarLastIndexOf;
+
+__attribute__((constructor))
+static void selectSearchKernels(void) {
+#ifdef SIMD_SEARCH
+	supportedSearchKernels = 2; // SSE2 is part of x86-64
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		supportedSearchKernels = 3;
+		if (__builtin_cpu_supports("avx512f"))
+			supportedSearchKernels = 4;
+	}
+#endif
+	indexOfKernel = searchKernels[supportedSearchKernels - 1].indexOf;
+	lastIndexOfKernel = searchKernels[supportedSearchKernels - 1].lastIndexOf;
+}
+
+#if defined(COLLECTION_TEST) && !defined(ARRAYLIST_SHARED_READS)
+/**
+ * Returns the pointer search kernels this CPU supports, the scalar one
+ * first and the one used by the list last, so that tests can check every
+ * kernel and not only the one picked at load time.  Only built with
+ * <tt>-DCOLLECTION_TEST</tt>.
+ *
+ * @param count receives the number of kernels returned
+ * @return the kernels
+ */
+const list_SearchKernels* list_searchKernels(size_t* count) {
+	*count = supportedSearchKernels;
+	return searchKernels;
+}
+#endif
+
+
+
+// Sorted Search
+
+/*
+ * Binary searches over array[0, n) sorted by c.  The loop keeps a base and
+ * halves the length, choosing the next base with a conditional move rather
+ * than a branch, and prefetches both halves it may continue into, so that
+ * the search does not stall on mispredictions or on cache misses on large
+ * lists.
+ */
+static int64_t searchLowerBound(void** array, int64_t n, void* key, list_Comparator c) {
+	if (n == 0)
+		return 0;
+	void** base = array;
+	while (n > 1) {
+		int64_t half = n / 2;
+		__builtin_prefetch(base + half / 2);
+		__builtin_prefetch(base + half + half / 2);
+		base = COMPARE(c, base[half], key) < 0 ? base + half : base;
+		n -= half;
+	}
+	return base - array + (COMPARE(c, *base, key) < 0);
+}
+
+static int64_t searchUpperBound(void** array, int64_t n, void* key, list_Comparator c) {
+	if (n == 0)
+		return 0;
+	void** base = array;
+	while (n > 1) {
+		int64_t half = n / 2;
+		__builtin_prefetch(base + half / 2);
+		__builtin_prefetch(base + half + half / 2);
+		base = COMPARE(c, base[half], key) <= 0 ? base + half : base;
+		n -= half;
+	}
+	return base - array + (COMPARE(c, *base, key) <= 0);
+}
+
+/*
+ * Returns the index of the first (or last) element identical to o.  On a
+ * sorted list only the elements equal to o need to be scanned.
+ */
+static int64_t findFirst(ArrayList* arrList, void* o) {
+	int64_t lo = 0, hi = arrList->size;
+	if (arrList->comparator != NULL) {
+		lo = searchLowerBound(arrList->array, arrList->size, o, arrList->comparator);
+		hi = searchUpperBound(arrList->array, arrList->size, o, arrList->comparator);
+	}
+	int64_t i = indexOfKernel(arrList->array + lo, hi - lo, o);
+	STATS(countComparisons(arrList, i < 0 ? hi - lo : i + 1));
+	return i < 0 ? -1 : lo + i;
+}
+
+static int64_t findLast(ArrayList* arrList, void* o) {
+	int64_t lo = 0, hi = arrList->size;
+	if (arrList->comparator != NULL) {
+		lo = searchLowerBound(arrList->array, arrList->size, o, arrList->comparator);
+		hi = searchUpperBound(arrList->array, arrList->size, o, arrList->comparator);
+	}
+	int64_t i = lastIndexOfKernel(arrList->array + lo, hi - lo, o);
+	STATS(countComparisons(arrList, i < 0 ? hi - lo : hi - lo - i));
+	return i < 0 ? -1 : lo + i;
 }
 
 
@@ -71,7 +917,7 @@ bool list_delList(list_List list) {
  * @return the number of elements in this list
  */
 int64_t list_size(list_List list) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	return arrList->size;
 }
 
@@ -81,7 +927,7 @@ int64_t list_size(list_List list) {
  * @return <tt>true</tt> if this list contains no elements
  */
 bool list_isEmpty(list_List list) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	return arrList->size == 0;
 }
 
@@ -99,11 +945,9 @@ bool list_isEmpty(list_List list) {
  * list does not permit null elements (optional)
  */
 bool list_contains(list_List list, void* o) {
-	ArrayList* arrList = (ArrayList*) list;
-	for (int64_t i = 0; i < arrList->size; ++i)
-		if (arrList->array[i] == o)
-			return true;
-	return false;
+	ArrayList* arrList = syncView(list);
+	STATS(++arrList->stats.calls[LIST_STATS_SEARCH]);
+	return findFirst(arrList, o) >= 0;
 }
 
 /**
@@ -122,7 +966,7 @@ bool list_contains(list_List list, void* o) {
  * sequence
  */
 void** list_toArray(list_List list) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	void** result = NULL;
 	result = malloc(sizeof(void*) * arrList->size);
 	assert(result != NULL);
@@ -158,14 +1002,23 @@ void** list_toArray(list_List list) {
  * prevents it from being added to this list
  */
 bool list_add(list_List list, void* e) {
-	ArrayList* arrList = (ArrayList*) list;
-	if (arrList->size == arrList->maxSize) {
-		void** temp = realloc(arrList->array, sizeof(void*) * (arrList->maxSize + REALLOC_INTERVAL));
-		assert(temp != NULL);
-		arrList->array = temp;
-		arrList->maxSize += REALLOC_INTERVAL;
+	ArrayList* arrList = syncView(list);
+	unshare(arrList, arrList->size);
+	if (arrList->comparator != NULL && arrList->size > 0
+			&& COMPARE(arrList->comparator, arrList->array[arrList->size - 1], e) > 0)
+		clearSorted(arrList);
+	if (arrList->superList == NULL && arrList->size < arrList->maxSize) {
+		// appending to a list that is not a view moves nothing
+		SET_SLOT(arrList->array[arrList->size], e);
+		SET_SIZE(arrList, arrList->size + 1);
+		++arrList->modCount;
+	} else {
+		openGap(arrList, arrList->size, 1);
+		SET_SLOT(arrList->array[arrList->size - 1], e);
 	}
-	arrList->array[arrList->size++] = e;
+	STATS(++arrList->stats.calls[LIST_STATS_ADD]);
+	STATS(countPeak(arrList));
+	STATS(countComparisons(arrList, 0));
 	return true;
 }
 
@@ -189,18 +1042,13 @@ bool list_add(list_List list, void* e) {
  * is not supported by this list
  */
 bool list_remove(list_List list, void* o) {
-	ArrayList* arrList = (ArrayList*) list;
-	int64_t i;
-	for (i = 0; i < arrList->size; ++i)
-		if (arrList->array[i] == o)
-			break;
-	if (i == arrList->size)
+	ArrayList* arrList = syncView(list);
+	int64_t i = findFirst(arrList, o);
+	if (i < 0)
 		return false;
-	int64_t newSize = arrList->size - 1;
-	for (; i < newSize; ++i)
-		arrList->array[i] = arrList->array[i + 1];
-	arrList->array[i] = NULL;
-	arrList->size = newSize;
+	unshare(arrList, arrList->size);
+	closeGap(arrList, i, i + 1);
+	STATS(++arrList->stats.calls[LIST_STATS_REMOVE]);
 	return true;
 }
 
@@ -208,6 +1056,34 @@ bool list_remove(list_List list, void* o) {
 
 // Bulk Modification Operations
 
+/*
+ * Stable single pass compaction shared by removeAll and retainAll.  Every
+ * occurrence in arr matches the first list element equal to it that has
+ * not been matched yet; matched elements are kept when retain is true and
+ * dropped otherwise.
+ */
+static bool filterList(ArrayList* arrList, void* arr[], size_t arrLength, bool retain) {
+	Multiset set;
+	unshare(arrList, arrList->size);
+	multisetInit(&set, arrList->allocator, arr, arrLength);
+	// kept elements are moved a run at a time
+	int64_t newSize = 0;
+	int64_t runStart = 0;
+	for (int64_t i = 0; i < arrList->size; ++i)
+		if (multisetTake(&set, arrList->array[i]) != retain) {
+			moveBlock(arrList, runStart, newSize, i - runStart);
+			newSize += i - runStart;
+			runStart = i + 1;
+		}
+	moveBlock(arrList, runStart, newSize, arrList->size - runStart);
+	newSize += arrList->size - runStart;
+	multisetFree(&set);
+	bool changed = newSize != arrList->size;
+	closeGap(arrList, newSize, arrList->size);
+	STATS(++arrList->stats.calls[LIST_STATS_REMOVE_ALL]);
+	return changed;
+}
+
 /**
  * Returns <tt>true</tt> if this list contains all of the elements of the
  * specified collection.
@@ -224,29 +1100,21 @@ bool list_remove(list_List list, void* o) {
  * @see #contains(void*)
  */
 bool list_containsAll(list_List list, void* arr[], size_t arrLength) {
-	ArrayList* arrList = (ArrayList*) list;
-	bool visited[arrList->size] = {}; // initially set to false
-	int64_t j; // let's not reallocate stack space for this
-	for (size_t i = 0; i < arrLength; ++i) {
-		for (j = 0; j < arrList->size; ++j)
-			if (!visited[j]) 
-				if (arrList->array[j] == arr[i]) {
-					visited[j] = true;
-					break;
-				} 
-		if (j == arrList->size)
-			return false;
-	}
-	return true;
-}
-
-static void bulkUpdateSize(ArrayList* arrList, int64_t newSize) {
-	if (newSize >= arrList->maxSize) {
-		void* temp = realloc(arrList->array, sizeof(void*) * (newSize += REALLOC_INTERVAL));
-		assert(temp != NULL);
-		arrList->array = temp;
-		arrList->maxSize = newSize;
-	}
+	ArrayList* arrList = syncView(list);
+	if (arrLength > (size_t) arrList->size)
+		return false;
+	Multiset set;
+	multisetInit(&set, arrList->allocator, arr, arrLength);
+	// each list element may satisfy at most one occurrence in arr
+	size_t remaining = arrLength;
+	int64_t i = 0;
+	for (; i < arrList->size && remaining > 0; ++i)
+		if (multisetTake(&set, arrList->array[i]))
+			--remaining;
+	multisetFree(&set);
+	STATS(++arrList->stats.calls[LIST_STATS_SEARCH]);
+	STATS(countComparisons(arrList, i));
+	return remaining == 0;
 }
 
 /**
@@ -271,12 +1139,14 @@ static void bulkUpdateSize(ArrayList* arrList, int64_t newSize) {
  * @see #add(void*)
  */
 bool list_addAll(list_List list, void* arr[], size_t arrLength) {
-	ArrayList* arrList = (ArrayList*) list;
-	int64_t newSize = arrList->size + arrLength;	
-	bulkUpdateSize(arrList, newSize);
-	for (int64_t i = 0; i < arrLength; ++i) 
-		arrList->array[i + arrList->size] = arr[i];
-	arrList->size += arrLength;
+	ArrayList* arrList = syncView(list);
+	int64_t end = arrList->size;
+	unshare(arrList, arrList->size);
+	clearSorted(arrList);
+	openGap(arrList, end, arrLength);
+	copySlots(arrList->array + end, arr, arrLength);
+	STATS(++arrList->stats.calls[LIST_STATS_ADD_ALL]);
+	STATS(countPeak(arrList));
 	return true;
 }
 
@@ -308,15 +1178,10 @@ bool list_addAll(list_List list, void* arr[], size_t arrLength) {
  * (<tt>index &lt; 0 || index &gt; size()</tt>)
  */
 bool list_addAllAt(list_List list, int64_t index, void* arr[], size_t arrLength) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	assert(index >= 0 && index <= arrList->size);
-	int64_t newSize = arrList->size + arrLength;
-	bulkUpdateSize(arrList, newSize);
-	void** array = arrList->array;
-	for (size_t i = 0; i < arrLength; ++i) {
-		array[arrLength + i] = array[index + i];
-		array[index + i] = arr[i];
-	}
+	list_insertGap(list, index, arrLength);
+	copySlots(arrList->array + index, arr, arrLength);
 	return true;
 }
 
@@ -337,33 +1202,8 @@ bool list_addAllAt(list_List list, int64_t index, void* arr[], size_t arrLength)
  * @see #contains(void*)
  */
 bool list_removeAll(list_List list, void* arr[], size_t arrLength) {
-	ArrayList* arrList = (ArrayList*) list;
-	bool visited[arrList->size] = {}; // initially set to false
-	int64_t j; // let's not reallocate stack space for this
-	// visited array saves which list indexes are in array arr
-	for (size_t i = 0; i < arrLength; ++i) {
-		for (j = 0; j < arrList->size; ++j)
-			if (!visited[j]) 
-				if (arrList->array[j] == arr[i]) {
-					visited[j] = true;
-					break;
-				} 
-	}
-	for (int64_t i = arrList->size - 1; i >= 0; --i)
-		if (visited[i]) {
-			if (i == arrList->size)
-				--arrList->size;
-			else {
-				for (j = i; visited[j]; --j); // finds visited region
-				int64_t index = j + 1;
-				int64_t newSize = arrList->size - i + index - 1;
-				int64_t rmSize = i - index + 1;
-				for (int64_t k = index; k < newSize; ++k)
-					arrList->array[k] = arrList->array[k + rmSize];
-				arrList->size = newSize;
-				i = index;
-			}
-		}
+	ArrayList* arrList = syncView(list);
+	return filterList(arrList, arr, arrLength, false);
 }
 
 /**
@@ -385,34 +1225,8 @@ bool list_removeAll(list_List list, void* arr[], size_t arrLength) {
  * @see #contains(void*)
  */
 bool list_retainAll(list_List list, void* arr[], size_t arrLength) {
-	ArrayList* arrList = (ArrayList*) list;
-	bool visited[arrList->size] = {}; // initially set to false
-	int64_t j; // let's not reallocate stack space for this
-	// visited array saves which list indexes are in array arr
-	for (size_t i = 0; i < arrLength; ++i) {
-		for (j = 0; j < arrList->size; ++j)
-			if (!visited[j]) 
-				if (arrList->array[j] == arr[i]) {
-					visited[j] = true;
-					break;
-				} 
-	}
-	for (int64_t i = arrList->size - 1; i >= 0; --i)
-		if (!visited[i]) {
-			if (i == arrList->size)
-				--arrList->size;
-			else {
-				for (j = i; !visited[j]; --j); // finds non visited region
-				int64_t index = j + 1;
-				int64_t newSize = arrList->size - i + index - 1;
-				int64_t rmSize = i - index + 1;
-				for (int64_t k = index; k < newSize; ++k)
-					arrList->array[k] = arrList->array[k + rmSize];
-				arrList->size = newSize;
-				i = index;
-			}
-		}
-
+	ArrayList* arrList = syncView(list);
+	return filterList(arrList, arr, arrLength, true);
 }
 
 /**
@@ -423,8 +1237,10 @@ bool list_retainAll(list_List list, void* arr[], size_t arrLength) {
  * is not supported by this list
  */
 void list_clear(list_List list) {
-	ArrayList* arrList = (ArrayList*) list;
-	arrList->size = 0;
+	ArrayList* arrList = syncView(list);
+	unshare(arrList, 0);
+	closeGap(arrList, 0, arrList->size);
+	STATS(++arrList->stats.calls[LIST_STATS_REMOVE_ALL]);
 }
 
 
@@ -446,8 +1262,8 @@ void list_clear(list_List list) {
  * @return <tt>true</tt> if the specified object is equal to this list
  */
 bool list_equals(list_List list, list_List o) {
-	ArrayList* arrList = (ArrayList*) list;
-	ArrayList* arrList2 = (ArrayList*) o;
+	ArrayList* arrList = syncView(list);
+	ArrayList* arrList2 = syncView(o);
 	if (arrList->size != arrList2->size) 
 		return false;
 	for (int64_t i = 0; i < arrList->size; ++i)
@@ -469,8 +1285,9 @@ bool list_equals(list_List list, list_List o) {
  * (<tt>index &lt; 0 || index &gt;= size()</tt>)
  */
 void* list_get(list_List list, int64_t index) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	assert(index >= 0 && index < arrList->size);
+	STATS(++arrList->stats.calls[LIST_STATS_GET]);
 	return arrList->array[index];
 }
 
@@ -493,10 +1310,14 @@ void* list_get(list_List list, int64_t index) {
  * (<tt>index &lt; 0 || index &gt;= size()</tt>)
  */
 void* list_set(list_List list, int64_t index, void* element) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	assert(index >= 0 && index < arrList->size);
+	unshare(arrList, arrList->size);
+	clearSorted(arrList);
+	recordReorder(arrList);
 	void* result = arrList->array[index];
-	arrList->array[index] = element;
+	SET_SLOT(arrList->array[index], element);
+	STATS(++arrList->stats.calls[LIST_STATS_SET]);
 	return result;
 }
 
@@ -537,15 +1358,59 @@ void list_addAt(list_List list, int64_t index, void* element) {
  * (<tt>index &lt; 0 || index &gt;= size()</tt>)
  */
 void* list_removeAt(list_List list, int64_t index) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	assert(index >= 0 && index < arrList->size);
+	unshare(arrList, arrList->size);
 	void* result = arrList->array[index];
-	--arrList->size;
-	for (int64_t i = index; i < arrList->size; ++i)
-		arrList->array[i] = arrList->array[i + 1];
+	closeGap(arrList, index, index + 1);
+	STATS(++arrList->stats.calls[LIST_STATS_REMOVE]);
 	return result;
 }
 
+/**
+ * Removes from this list all of the elements whose index is between
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  Shifts
+ * any succeeding elements to the left (reduces their index) with a single
+ * block move.  If <tt>toIndex==fromIndex</tt>, this operation has no
+ * effect.
+ *
+ * @param fromIndex index of first element to be removed
+ * @param toIndex index after last element to be removed
+ * @throws IndexOutOfBoundsException if <tt>fromIndex</tt> or
+ * <tt>toIndex</tt> is out of range
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size() || toIndex &lt; fromIndex</tt>)
+ */
+void list_removeRange(list_List list, int64_t fromIndex, int64_t toIndex) {
+	ArrayList* arrList = syncView(list);
+	assert(fromIndex >= 0 && toIndex <= arrList->size && toIndex >= fromIndex);
+	unshare(arrList, arrList->size);
+	closeGap(arrList, fromIndex, toIndex);
+	STATS(++arrList->stats.calls[LIST_STATS_REMOVE]);
+}
+
+/**
+ * Inserts <tt>n</tt> null elements at the specified position in this
+ * list.  Shifts the element currently at that position (if any) and any
+ * subsequent elements to the right (adds <tt>n</tt> to their indices)
+ * with a single block move.  The new slots can then be filled with
+ * {@link #set(int64_t, void*)}.
+ *
+ * @param index index at which the first null element is to be inserted
+ * @param n number of elements to insert
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+void list_insertGap(list_List list, int64_t index, int64_t n) {
+	ArrayList* arrList = syncView(list);
+	assert(index >= 0 && index <= arrList->size && n >= 0);
+	unshare(arrList, arrList->size);
+	clearSorted(arrList);
+	openGap(arrList, index, n);
+	clearSlots(arrList->array + index, n);
+	STATS(++arrList->stats.calls[LIST_STATS_INSERT]);
+	STATS(countPeak(arrList));
+}
+
 
 
 // Search Operations
@@ -566,11 +1431,9 @@ void* list_removeAt(list_List list, int64_t index) {
  * list does not permit null elements (optional)
  */
 int64_t list_indexOf(list_List list, void* o) {
-	ArrayList* arrList = (ArrayList*) list;
-	for (int64_t i = 0; i < arrList->size; ++i)
-		if (arrList->array[i] == o)
-			return i;
-	return -1;
+	ArrayList* arrList = syncView(list);
+	STATS(++arrList->stats.calls[LIST_STATS_SEARCH]);
+	return findFirst(arrList, o);
 }
 
 /**
@@ -589,11 +1452,866 @@ int64_t list_indexOf(list_List list, void* o) {
  * list does not permit null elements (optional)
  */
 int64_t list_lastIndexOf(list_List list, void* o) {
-	ArrayList* arrList = (ArrayList*) list;
-	for (int64_t i = arrList->size - 1; i >= 0; --i)
-		if (arrList->array[i] == o)
+	ArrayList* arrList = syncView(list);
+	STATS(++arrList->stats.calls[LIST_STATS_SEARCH]);
+	return findLast(arrList, o);
+}
+
+
+
+// Streaming Operations
+
+// spare slots offered to a reader at least, and the chunk of the pipeline
+#define INGEST_CHUNK 4096
+
+/**
+ * Appends every element produced by <tt>reader</tt> to the end of this
+ * list, in order, until it returns 0.  The reader writes straight into the
+ * spare capacity at the end of the backing array, which grows by the
+ * list's growth policy whenever less than a chunk is left, so input of
+ * unknown length is never staged in a temporary array.  On a view the
+ * reader fills a chunk opened at the end of the view, which shifts the
+ * elements that follow the view twice per call.
+ *
+ * @param reader the source of the elements
+ * @param context passed to every call of <tt>reader</tt>
+ * @return number of elements appended
+ */
+int64_t list_addAllFrom(list_List list, list_Reader reader, void* context) {
+	ArrayList* arrList = syncView(list);
+	int64_t added = 0;
+	unshare(arrList, arrList->size);
+	ArrayList* root = arrList->root;
+	for (;;) {
+		if (root->maxSize - root->size < INGEST_CHUNK)
+			bulkUpdateSize(root, root->size + INGEST_CHUNK);
+		// a view reads into a chunk opened at its end, a root into all of its slack
+		size_t capacity = root == arrList ? root->maxSize - root->size : INGEST_CHUNK;
+		int64_t end = arrList->size;
+		openGap(arrList, end, capacity);
+		size_t n = reader(context, arrList->array + end, capacity);
+		assert(n <= capacity);
+		closeGap(arrList, end + n, arrList->size);
+		if (n == 0)
+			break;
+		added += n;
+	}
+	if (added > 0)
+		clearSorted(arrList);
+	STATS(++arrList->stats.calls[LIST_STATS_ADD_ALL]);
+	STATS(countPeak(arrList));
+	return added;
+}
+
+/*
+ * Two chunk buffers handed back and forth between the helper thread, which
+ * fills them from the reader, and the appending thread, which drains them.
+ */
+typedef struct {
+	list_Reader reader;
+	void* context;
+	void** chunks[2];
+	size_t lengths[2];
+	bool full[2];
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+} Pipeline;
+
+static void* runReader(void* argument) {
+	Pipeline* pipeline = argument;
+	for (int b = 0;; b ^= 1) {
+		pthread_mutex_lock(&pipeline->lock);
+		while (pipeline->full[b])
+			pthread_cond_wait(&pipeline->changed, &pipeline->lock);
+		pthread_mutex_unlock(&pipeline->lock);
+		size_t n = pipeline->reader(pipeline->context, pipeline->chunks[b], INGEST_CHUNK);
+		assert(n <= INGEST_CHUNK);
+		pthread_mutex_lock(&pipeline->lock);
+		pipeline->lengths[b] = n;
+		pipeline->full[b] = true;
+		pthread_cond_signal(&pipeline->changed);
+		pthread_mutex_unlock(&pipeline->lock);
+		if (n == 0)
+			return NULL;
+	}
+}
+
+/**
+ * Appends every element produced by <tt>reader</tt>, as
+ * {@link #addAllFrom} does, while a helper thread calls the reader.  The
+ * helper fills one of two fixed size chunk buffers while this thread
+ * appends the other, so a slow reader, such as one reading a socket or a
+ * file, overlaps with the growth of the list.  The memory used beyond the
+ * list itself is the two chunks, whatever the length of the input.  The
+ * reader is called from the helper thread only, one call at a time.
+ *
+ * @param reader the source of the elements
+ * @param context passed to every call of <tt>reader</tt>
+ * @return number of elements appended
+ */
+int64_t list_addAllFromPipelined(list_List list, list_Reader reader, void* context) {
+	ArrayList* arrList = syncView(list);
+	const collection_Allocator* allocator = arrList->allocator;
+	size_t chunksBytes = sizeof(void*) * INGEST_CHUNK * 2;
+	Pipeline pipeline;
+	pipeline.reader = reader;
+	pipeline.context = context;
+	pipeline.chunks[0] = allocator->allocate(allocator->context, chunksBytes);
+	assert(pipeline.chunks[0] != NULL);
+	pipeline.chunks[1] = pipeline.chunks[0] + INGEST_CHUNK;
+	pipeline.full[0] = pipeline.full[1] = false;
+	pthread_mutex_init(&pipeline.lock, NULL);
+	pthread_cond_init(&pipeline.changed, NULL);
+	unshare(arrList, arrList->size);
+	pthread_t helper;
+	pthread_create(&helper, NULL, runReader, &pipeline);
+	int64_t added = 0;
+	for (int b = 0;; b ^= 1) {
+		pthread_mutex_lock(&pipeline.lock);
+		while (!pipeline.full[b])
+			pthread_cond_wait(&pipeline.changed, &pipeline.lock);
+		size_t n = pipeline.lengths[b];
+		pthread_mutex_unlock(&pipeline.lock);
+		if (n == 0)
+			break;
+		int64_t end = arrList->size;
+		openGap(arrList, end, n);
+		memcpy(arrList->array + end, pipeline.chunks[b], sizeof(void*) * n);
+		added += n;
+		pthread_mutex_lock(&pipeline.lock);
+		pipeline.full[b] = false;
+		pthread_cond_signal(&pipeline.changed);
+		pthread_mutex_unlock(&pipeline.lock);
+	}
+	pthread_join(helper, NULL);
+	pthread_cond_destroy(&pipeline.changed);
+	pthread_mutex_destroy(&pipeline.lock);
+	allocator->deallocate(allocator->context, pipeline.chunks[0], chunksBytes);
+	if (added > 0)
+		clearSorted(arrList);
+	STATS(++arrList->stats.calls[LIST_STATS_ADD_ALL]);
+	STATS(countPeak(arrList));
+	return added;
+}
+
+
+
+// Sorting Operations
+
+/*
+ * Natural merge sort in the manner of timsort: the array is cut into
+ * ascending runs (strictly descending ones are reversed), runs shorter than
+ * MIN_RUN are extended by binary insertion sort, and neighbouring runs are
+ * merged pairwise until one is left.  A merge first skips the prefix of the
+ * left run and the suffix of the right run that are already in place, then
+ * copies the shorter of what remains to the buffer, so it needs at most
+ * half of the array as scratch space.
+ *
+ * The parallel sort cuts the array into one slice per thread and sorts the
+ * slices independently.  It then merges pairs of slices out of place,
+ * alternating between the array and a buffer of the same size; when there
+ * are fewer pairs than threads each merge is split further by the co-rank
+ * of its output positions, so every round keeps all threads busy.
+ */
+
+#define MIN_RUN 32
+#define PARALLEL_SORT_MIN_SIZE 65536
+
+static void reverseRun(void** array, int64_t lo, int64_t hi) {
+	for (--hi; lo < hi; ++lo, --hi) {
+		void* temp = array[lo];
+		array[lo] = array[hi];
+		array[hi] = temp;
+	}
+}
+
+/*
+ * Returns the end of the run starting at lo, reversing it first if it is
+ * strictly descending.
+ */
+static int64_t runEnd(void** array, int64_t lo, int64_t hi, list_Comparator c) {
+	int64_t end = lo + 1;
+	if (end == hi)
+		return end;
+	if (COMPARE(c, array[end++], array[lo]) < 0) {
+		while (end < hi && COMPARE(c, array[end], array[end - 1]) < 0)
+			++end;
+		reverseRun(array, lo, end);
+	} else
+		while (end < hi && COMPARE(c, array[end], array[end - 1]) >= 0)
+			++end;
+	return end;
+}
+
+/*
+ * Sorts array[lo, hi) by binary insertion, given that array[lo, start) is
+ * already sorted.
+ */
+static void insertionSort(void** array, int64_t lo, int64_t start, int64_t hi,
+		list_Comparator c) {
+	for (int64_t i = start; i < hi; ++i) {
+		void* pivot = array[i];
+		int64_t left = lo;
+		int64_t right = i;
+		while (left < right) {
+			int64_t mid = left + (right - left) / 2;
+			if (COMPARE(c, pivot, array[mid]) < 0)
+				right = mid;
+			else
+				left = mid + 1;
+		}
+		memmove(array + left + 1, array + left, sizeof(void*) * (i - left));
+		array[left] = pivot;
+	}
+}
+
+/*
+ * Merges the sorted runs array[lo, mid) and array[mid, hi) in place.
+ */
+static void mergeRuns(void** array, int64_t lo, int64_t mid, int64_t hi, void** buffer,
+		list_Comparator c) {
+	if (COMPARE(c, array[mid - 1], array[mid]) <= 0)
+		return;
+	lo += searchUpperBound(array + lo, mid - lo, array[mid], c);
+	hi = mid + searchLowerBound(array + mid, hi - mid, array[mid - 1], c);
+	int64_t leftLength = mid - lo;
+	int64_t rightLength = hi - mid;
+	if (leftLength <= rightLength) {
+		memcpy(buffer, array + lo, sizeof(void*) * leftLength);
+		int64_t i = 0, j = mid, k = lo;
+		while (i < leftLength && j < hi)
+			array[k++] = COMPARE(c, array[j], buffer[i]) < 0 ? array[j++] : buffer[i++];
+		memcpy(array + k, buffer + i, sizeof(void*) * (leftLength - i));
+	} else {
+		memcpy(buffer, array + mid, sizeof(void*) * rightLength);
+		int64_t i = mid - 1, j = rightLength - 1, k = hi - 1;
+		while (i >= lo && j >= 0)
+			array[k--] = COMPARE(c, buffer[j], array[i]) < 0 ? array[i--] : buffer[j--];
+		memcpy(array + lo, buffer, sizeof(void*) * (j + 1));
+	}
+}
+
+// number of run boundaries sortArray needs for n elements
+static int64_t boundCount(int64_t n) {
+	return n / MIN_RUN + 2;
+}
+
+/*
+ * Sorts array[0, n) with buffer holding n / 2 elements and bounds holding
+ * boundCount(n) entries.
+ */
+static void sortArray(void** array, int64_t n, list_Comparator c, void** buffer,
+		int64_t* bounds) {
+	if (n < 2)
+		return;
+	int64_t runs = 0;
+	bounds[0] = 0;
+	for (int64_t lo = 0; lo < n;) {
+		int64_t end = runEnd(array, lo, n, c);
+		if (end - lo < MIN_RUN) {
+			int64_t forced = lo + MIN_RUN < n ? lo + MIN_RUN : n;
+			insertionSort(array, lo, end, forced, c);
+			end = forced;
+		}
+		bounds[++runs] = end;
+		lo = end;
+	}
+	while (runs > 1) {
+		int64_t merged = 0;
+		for (int64_t r = 0; r < runs; r += 2) {
+			if (r + 1 < runs)
+				mergeRuns(array, bounds[r], bounds[r + 1], bounds[r + 2], buffer, c);
+			bounds[++merged] = bounds[r + 1 < runs ? r + 2 : r + 1];
+		}
+		runs = merged;
+	}
+}
+
+/**
+ * Sorts this list in place according to the order induced by the
+ * specified comparator.  The sort is stable: equal elements keep their
+ * relative order.  Runs already in ascending or strictly descending order
+ * are detected and merged rather than re-sorted, so nearly sorted input
+ * is sorted in close to linear time.  The scratch space used is at most
+ * half the size of the list.  Afterwards the list is sorted by <tt>c</tt>,
+ * as after {@link #assumeSorted}.  Sorting is a structural modification:
+ * other views of the list it belongs to become stale.
+ *
+ * @param c the comparator used to compare list elements
+ */
+void list_sort(list_List list, list_Comparator c) {
+	ArrayList* arrList = syncView(list);
+	const collection_Allocator* allocator = arrList->allocator;
+	int64_t n = arrList->size;
+	unshare(arrList, n);
+	recordModification(arrList);
+	recordReorder(arrList);
+	clearSorted(arrList);
+	arrList->comparator = c;
+	STATS(++arrList->stats.calls[LIST_STATS_SORT]);
+	if (n < 2)
+		return;
+	size_t bufferBytes = sizeof(void*) * (n / 2 + 1);
+	size_t boundsBytes = sizeof(int64_t) * boundCount(n);
+	void** buffer = allocator->allocate(allocator->context, bufferBytes);
+	int64_t* bounds = allocator->allocate(allocator->context, boundsBytes);
+	assert(buffer != NULL && bounds != NULL);
+	sortArray(arrList->array, n, c, buffer, bounds);
+	STATS(countComparisons(arrList, 0));
+	allocator->deallocate(allocator->context, bounds, boundsBytes);
+	allocator->deallocate(allocator->context, buffer, bufferBytes);
+}
+
+typedef struct {
+	void** array;
+	int64_t n;
+	void** buffer;
+	int64_t* bounds;
+	list_Comparator c;
+#ifdef COLLECTION_STATS
+	uint64_t comparisons;
+#endif
+} SliceSort;
+
+static void* runSliceSort(void* arg) {
+	SliceSort* task = arg;
+	STATS(uint64_t before = takeComparisons());
+	sortArray(task->array, task->n, task->c, task->buffer, task->bounds);
+	STATS(task->comparisons = takeComparisons());
+	STATS(threadComparisons = before);
+	return NULL;
+}
+
+/*
+ * Writes to dst[from, to) the elements that land there when src[lo, mid)
+ * and src[mid, hi) are merged.
+ */
+typedef struct {
+	void** src;
+	void** dst;
+	int64_t lo, mid, hi;
+	int64_t from, to;
+	list_Comparator c;
+#ifdef COLLECTION_STATS
+	uint64_t comparisons;
+#endif
+} MergeSlice;
+
+/*
+ * Returns how many of the first k merged elements of a and b come from a.
+ * Ties go to a, which keeps the merge stable.
+ */
+static int64_t coRank(int64_t k, void** a, int64_t aLength, void** b, int64_t bLength,
+		list_Comparator c) {
+	int64_t lo = k > bLength ? k - bLength : 0;
+	int64_t hi = k < aLength ? k : aLength;
+	for (;;) {
+		int64_t i = lo + (hi - lo) / 2;
+		int64_t j = k - i;
+		if (i > 0 && j < bLength && COMPARE(c, a[i - 1], b[j]) > 0)
+			hi = i - 1;
+		else if (j > 0 && i < aLength && COMPARE(c, b[j - 1], a[i]) >= 0)
+			lo = i + 1;
+		else
 			return i;
-	return -1;
+	}
+}
+
+static void* runMergeSlice(void* arg) {
+	MergeSlice* task = arg;
+	STATS(uint64_t before = takeComparisons());
+	void** a = task->src + task->lo;
+	void** b = task->src + task->mid;
+	int64_t aLength = task->mid - task->lo;
+	int64_t bLength = task->hi - task->mid;
+	int64_t i = coRank(task->from - task->lo, a, aLength, b, bLength, task->c);
+	int64_t j = task->from - task->lo - i;
+	int64_t iEnd = coRank(task->to - task->lo, a, aLength, b, bLength, task->c);
+	int64_t jEnd = task->to - task->lo - iEnd;
+	void** out = task->dst + task->from;
+	while (i < iEnd && j < jEnd)
+		*out++ = COMPARE(task->c, b[j], a[i]) < 0 ? b[j++] : a[i++];
+	memcpy(out, a + i, sizeof(void*) * (iEnd - i));
+	out += iEnd - i;
+	memcpy(out, b + j, sizeof(void*) * (jEnd - j));
+	STATS(task->comparisons = takeComparisons());
+	STATS(threadComparisons = before);
+	return NULL;
+}
+
+/**
+ * Sorts this list as {@link #sort} does, splitting the work across up to
+ * <tt>threads</tt> threads: each sorts one slice of the list, then the
+ * slices are merged pairwise, every merge itself split between the
+ * threads.  The comparator is called concurrently from several threads.
+ * Lists too small to benefit, or a single thread, fall back to
+ * {@link #sort}.  The scratch space used is the size of the list.
+ *
+ * @param c the comparator used to compare list elements
+ * @param threads maximum number of threads to sort with, at least 1
+ */
+void list_parallelSort(list_List list, list_Comparator c, int threads) {
+	ArrayList* arrList = syncView(list);
+	const collection_Allocator* allocator = arrList->allocator;
+	int64_t n = arrList->size;
+	assert(threads >= 1);
+	unshare(arrList, n);
+	if (threads == 1 || n < PARALLEL_SORT_MIN_SIZE) {
+		list_sort(list, c);
+		return;
+	}
+	size_t bufferBytes = sizeof(void*) * n;
+	size_t boundsBytes = sizeof(int64_t) * (boundCount(n) + 2 * threads);
+	size_t slicesBytes = sizeof(int64_t) * (threads + 1);
+	size_t tasksBytes = sizeof(MergeSlice) * (threads + 1);
+	size_t threadsBytes = sizeof(pthread_t) * (threads + 1);
+	void** buffer = allocator->allocate(allocator->context, bufferBytes);
+	int64_t* bounds = allocator->allocate(allocator->context, boundsBytes);
+	int64_t* slices = allocator->allocate(allocator->context, slicesBytes);
+	MergeSlice* tasks = allocator->allocate(allocator->context, tasksBytes);
+	pthread_t* workers = allocator->allocate(allocator->context, threadsBytes);
+	assert(buffer != NULL && bounds != NULL && slices != NULL && tasks != NULL && workers != NULL);
+
+	// sort one slice per thread, each with its own part of the scratch space
+	SliceSort* sorts = (SliceSort*) tasks;
+	assert(sizeof(SliceSort) <= sizeof(MergeSlice));
+	int64_t* sliceBounds = bounds;
+	for (int t = 0; t < threads; ++t) {
+		slices[t] = n * t / threads;
+		int64_t length = n * (t + 1) / threads - slices[t];
+		SliceSort task = { arrList->array + slices[t], length, buffer + slices[t], sliceBounds, c };
+		sorts[t] = task;
+		sliceBounds += boundCount(length);
+	}
+	slices[threads] = n;
+	for (int t = 1; t < threads; ++t)
+		pthread_create(&workers[t], NULL, runSliceSort, &sorts[t]);
+	runSliceSort(&sorts[0]);
+	for (int t = 1; t < threads; ++t)
+		pthread_join(workers[t], NULL);
+	STATS(uint64_t comparisons = 0);
+	STATS(for (int t = 0; t < threads; ++t) comparisons += sorts[t].comparisons);
+
+	// merge pairs of slices until one is left
+	void** src = arrList->array;
+	void** dst = buffer;
+	for (int runs = threads; runs > 1;) {
+		int pairs = runs / 2;
+		int perPair = threads / pairs;
+		int taskCount = 0;
+		for (int p = 0; p < pairs; ++p) {
+			int64_t lo = slices[2 * p], mid = slices[2 * p + 1], hi = slices[2 * p + 2];
+			for (int s = 0; s < perPair; ++s) {
+				MergeSlice task = { src, dst, lo, mid, hi,
+						lo + (hi - lo) * s / perPair, lo + (hi - lo) * (s + 1) / perPair, c };
+				tasks[taskCount++] = task;
+			}
+		}
+		if (runs % 2 != 0) {
+			// an odd slice out is merged with nothing, which copies it
+			int64_t lo = slices[runs - 1], hi = slices[runs];
+			MergeSlice task = { src, dst, lo, hi, hi, lo, hi, c };
+			tasks[taskCount++] = task;
+		}
+		for (int t = 1; t < taskCount; ++t)
+			pthread_create(&workers[t], NULL, runMergeSlice, &tasks[t]);
+		runMergeSlice(&tasks[0]);
+		for (int t = 1; t < taskCount; ++t)
+			pthread_join(workers[t], NULL);
+		STATS(for (int t = 0; t < taskCount; ++t) comparisons += tasks[t].comparisons);
+		int merged = 0;
+		for (int r = 0; r < runs; r += 2)
+			slices[++merged] = slices[r + 2 < runs ? r + 2 : runs];
+		runs = merged;
+		void** temp = src;
+		src = dst;
+		dst = temp;
+	}
+	if (src != arrList->array)
+		memcpy(arrList->array, src, sizeof(void*) * n);
+	recordModification(arrList);
+	recordReorder(arrList);
+	clearSorted(arrList);
+	arrList->comparator = c;
+	STATS(++arrList->stats.calls[LIST_STATS_SORT]);
+	STATS(countComparisons(arrList, comparisons));
+
+	allocator->deallocate(allocator->context, workers, threadsBytes);
+	allocator->deallocate(allocator->context, tasks, tasksBytes);
+	allocator->deallocate(allocator->context, slices, slicesBytes);
+	allocator->deallocate(allocator->context, bounds, boundsBytes);
+	allocator->deallocate(allocator->context, buffer, bufferBytes);
+}
+
+
+
+// Sorted List Operations
+
+/**
+ * Records that this list is sorted according to <tt>c</tt>.  While it
+ * is, {@link #contains}, {@link #indexOf}, {@link #lastIndexOf} and
+ * {@link #remove} only scan the elements that compare equal to their
+ * argument, found by binary search, so <tt>c</tt> is also called with
+ * their arguments.  Operations that keep the order ({@link #insertSorted},
+ * removals, and {@link #add} of an element not less than the last one)
+ * keep the list sorted; any other insertion or {@link #set} forgets the
+ * comparator, for this list and for the lists it is a view of; a
+ * {@link #set} also makes every other view of the same list forget it.
+ * The result of the sorted operations is undefined if the list is not
+ * actually sorted by <tt>c</tt>.
+ *
+ * @param c the comparator the list is sorted by
+ */
+void list_assumeSorted(list_List list, list_Comparator c) {
+	ArrayList* arrList = syncView(list);
+	assert(c != NULL);
+	arrList->comparator = c;
+}
+
+/**
+ * Returns the comparator this list is known to be sorted by, or
+ * <tt>NULL</tt> if it is not known to be sorted.
+ *
+ * @return the comparator of this sorted list, or <tt>NULL</tt>
+ */
+list_Comparator list_comparator(list_List list) {
+	ArrayList* arrList = syncView(list);
+	return arrList->comparator;
+}
+
+/**
+ * Searches this sorted list for an element equal to <tt>key</tt>
+ * according to the list's comparator.  If several elements are equal to
+ * the key, the index of the first is returned.
+ *
+ * @param key the key to search for
+ * @return the index of the first element equal to <tt>key</tt>, if any;
+ * otherwise <tt>(-(insertion point) - 1)</tt>, where the insertion point
+ * is the index of the first element greater than the key, or the size of
+ * the list if there is none
+ */
+int64_t list_binarySearch(list_List list, void* key) {
+	ArrayList* arrList = syncView(list);
+	assert(arrList->comparator != NULL);
+	int64_t i = searchLowerBound(arrList->array, arrList->size, key, arrList->comparator);
+	bool found = i < arrList->size && COMPARE(arrList->comparator, arrList->array[i], key) == 0;
+	STATS(++arrList->stats.calls[LIST_STATS_SEARCH]);
+	STATS(countComparisons(arrList, 0));
+	return found ? i : -i - 1;
+}
+
+/**
+ * Returns the index of the first element of this sorted list that is not
+ * less than <tt>key</tt>, or the size of the list if there is none.
+ *
+ * @param key the key to search for
+ * @return the lower bound of <tt>key</tt>
+ */
+int64_t list_lowerBound(list_List list, void* key) {
+	ArrayList* arrList = syncView(list);
+	assert(arrList->comparator != NULL);
+	int64_t i = searchLowerBound(arrList->array, arrList->size, key, arrList->comparator);
+	STATS(++arrList->stats.calls[LIST_STATS_SEARCH]);
+	STATS(countComparisons(arrList, 0));
+	return i;
+}
+
+/**
+ * Returns the index of the first element of this sorted list that is
+ * greater than <tt>key</tt>, or the size of the list if there is none.
+ * The elements equal to the key are those from its lower bound up to its
+ * upper bound.
+ *
+ * @param key the key to search for
+ * @return the upper bound of <tt>key</tt>
+ */
+int64_t list_upperBound(list_List list, void* key) {
+	ArrayList* arrList = syncView(list);
+	assert(arrList->comparator != NULL);
+	int64_t i = searchUpperBound(arrList->array, arrList->size, key, arrList->comparator);
+	STATS(++arrList->stats.calls[LIST_STATS_SEARCH]);
+	STATS(countComparisons(arrList, 0));
+	return i;
+}
+
+/**
+ * Inserts the specified element into this sorted list after every element
+ * not greater than it, with one binary search and one block move, and
+ * keeps the list sorted.
+ *
+ * @param e element to be inserted
+ * @return the index at which the element was inserted
+ */
+int64_t list_insertSorted(list_List list, void* e) {
+	ArrayList* arrList = syncView(list);
+	assert(arrList->comparator != NULL);
+	unshare(arrList, arrList->size);
+	int64_t index = searchUpperBound(arrList->array, arrList->size, e, arrList->comparator);
+	openGap(arrList, index, 1);
+	arrList->array[index] = e;
+	STATS(++arrList->stats.calls[LIST_STATS_INSERT]);
+	STATS(countPeak(arrList));
+	STATS(countComparisons(arrList, 0));
+	return index;
+}
+
+
+
+// Snapshot Operations
+
+/**
+ * Returns an immutable snapshot of this list: a list holding the elements
+ * this list holds now, which later changes to this list do not affect.
+ * The snapshot shares the backing array through a reference count, so
+ * taking and deleting it costs O(1) and copies nothing; the first
+ * modification of this list while a snapshot is alive gives the list a
+ * private copy of the array.  Modifying the snapshot, or a view of it, is
+ * an error.  Snapshots of views and of lists that keep their elements
+ * inside the header (see {@link #newSmallList}) are copies.
+ *
+ * <p>A snapshot may be read, snapshotted again and deleted from any thread
+ * while this list is being modified.  Taking a snapshot of this list
+ * itself reads it and must not race with its modification.  Modifying a
+ * view of this list while a snapshot shares its array gives this list its
+ * private copy, as modifying this list does.
+ *
+ * @return an immutable snapshot of this list
+ */
+list_List list_snapshot(list_List list) {
+	ArrayList* arrList = syncView(list);
+	const collection_Allocator* allocator = arrList->allocator;
+	ArrayList* result;
+	if (arrList->superList != NULL || usesInlineStorage(arrList) || arrList->maxSize == 0) {
+		// the array cannot be shared, snapshot a copy of the elements
+		void** array = NULL;
+		if (arrList->size > 0) {
+			array = allocator->allocate(allocator->context, sizeof(void*) * arrList->size);
+			assert(array != NULL);
+			memcpy(array, arrList->array, sizeof(void*) * arrList->size);
+		}
+		result = (ArrayList*) list_fromArrayWithAllocator(allocator,
+				array, arrList->size, arrList->size);
+		result->shareCount = allocator->allocate(allocator->context, sizeof(_Atomic int64_t));
+		assert(result->shareCount != NULL);
+		atomic_init(result->shareCount, 1);
+	} else {
+		if (arrList->shareCount == NULL) {
+			arrList->shareCount = allocator->allocate(allocator->context,
+					sizeof(_Atomic int64_t));
+			assert(arrList->shareCount != NULL);
+			atomic_init(arrList->shareCount, 1);
+		}
+		atomic_fetch_add_explicit(arrList->shareCount, 1, memory_order_relaxed);
+		result = allocator->allocate(allocator->context, sizeof(ArrayList));
+		assert(result != NULL);
+		*result = *arrList;
+		result->root = result;
+		result->hasInlineStorage = false;
+		STATS(registerList(result, arrList->site));
+	}
+	result->comparator = arrList->comparator;
+	result->readOnly = true;
+	STATS(moveToSite(result, arrList->site));
+	return (list_List) result;
+}
+
+
+
+// Statistics
+
+/**
+ * Copies the counters of this list to <tt>stats</tt>.  The slack is the
+ * number of unused slots in the backing array at the time of the call,
+ * always 0 for a snapshot, whose array belongs to the list it was taken
+ * from.
+ *
+ * @param stats receives the counters
+ * @return <tt>true</tt>, or <tt>false</tt> without touching
+ * <tt>stats</tt> if the library was built without
+ * <tt>-DCOLLECTION_STATS</tt>
+ */
+bool list_getStats(list_List list, list_Stats* stats) {
+#ifdef COLLECTION_STATS
+	ArrayList* arrList = (ArrayList*) list;
+	*stats = arrList->stats;
+	stats->slack = arrList->readOnly ? 0 : capacityOf(arrList) - arrList->size;
+	stats->file = arrList->site->file;
+	stats->line = arrList->site->line;
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * Records <tt>file</tt> and <tt>line</tt> as the place this list was
+ * created, under which {@link #dumpStats} reports it.  Usually called
+ * through <tt>LIST_SITE</tt>, which tags a list with the place it is
+ * used and compiles to nothing without <tt>-DCOLLECTION_STATS</tt>:
+ * <pre>
+ *   list_List list = LIST_SITE(list_newList());
+ * </pre>
+ * Lists that are not tagged are reported together, and views and
+ * snapshots inherit the site of their list.  Does nothing if the library
+ * was built without <tt>-DCOLLECTION_STATS</tt>.
+ *
+ * @param file name of the source file, which must outlive the list
+ * @param line line in the source file
+ * @return this list
+ */
+list_List list_tagSite(list_List list, const char* file, int line) {
+#ifdef COLLECTION_STATS
+	ArrayList* arrList = (ArrayList*) list;
+	Site* site;
+	pthread_mutex_lock(&statsLock);
+	for (site = sites; site != NULL; site = site->next)
+		if (site->line == line && (site->file == file
+				|| (site->file != NULL && file != NULL && strcmp(site->file, file) == 0)))
+			break;
+	if (site == NULL) {
+		site = calloc(1, sizeof(Site));
+		assert(site != NULL);
+		site->file = file;
+		site->line = line;
+		site->next = sites;
+		sites = site;
+	}
+	pthread_mutex_unlock(&statsLock);
+	moveToSite(arrList, site);
+#endif
+	return list;
+}
+
+#ifdef COLLECTION_STATS
+static const char* operationNames[LIST_STATS_OPERATIONS] = {
+	"add", "insert", "addAll", "remove", "removeAll", "get", "set", "search", "sort"
+};
+
+static void dumpLine(int fd, const char* file, int line, int64_t lists, int64_t live,
+		const list_Stats* stats) {
+	if (file != NULL)
+		dprintf(fd, "%s:%d", file, line);
+	else
+		dprintf(fd, "%s", line < 0 ? "total" : "untagged");
+	dprintf(fd, " lists=%lld live=%lld", (long long) lists, (long long) live);
+	for (int op = 0; op < LIST_STATS_OPERATIONS; ++op)
+		dprintf(fd, " %s=%llu", operationNames[op], (unsigned long long) stats->calls[op]);
+	dprintf(fd, " reallocs=%llu shifted=%llu comparisons=%llu peakSize=%lld slack=%lld\n",
+			(unsigned long long) stats->reallocs, (unsigned long long) stats->elementsShifted,
+			(unsigned long long) stats->comparisons, (long long) stats->peakSize,
+			(long long) stats->slack);
+}
+
+typedef struct {
+	Site* site;
+	int64_t lists;
+	int64_t live;
+	list_Stats stats;
+} SiteTotal;
+
+static int compareSiteTotals(const void* a, const void* b) {
+	uint64_t x = ((const SiteTotal*) a)->stats.elementsShifted;
+	uint64_t y = ((const SiteTotal*) b)->stats.elementsShifted;
+	return (x < y) - (x > y);
+}
+#endif
+
+/**
+ * Writes one line to <tt>fd</tt> with the counters summed over every list
+ * ever created, then one line per creation site (see {@link #tagSite})
+ * with the counters of its lists, live and deleted, the site that shifted
+ * the most elements first.  The counters of lists being modified by other
+ * threads meanwhile are read without synchronization and may be slightly
+ * out of date.  Writes a single note if the library was built without
+ * <tt>-DCOLLECTION_STATS</tt>.
+ *
+ * @param fd file descriptor to write to
+ */
+void list_dumpStats(int fd) {
+#ifdef COLLECTION_STATS
+	pthread_mutex_lock(&statsLock);
+	size_t count = 0;
+	for (Site* site = sites; site != NULL; site = site->next)
+		++count;
+	SiteTotal* totals = calloc(count, sizeof(SiteTotal));
+	assert(totals != NULL);
+	SiteTotal all;
+	memset(&all, 0, sizeof(all));
+	size_t i = 0;
+	for (Site* site = sites; site != NULL; site = site->next, ++i) {
+		SiteTotal* total = &totals[i];
+		total->site = site;
+		total->lists = site->lists;
+		total->stats = site->retired;
+		for (ArrayList* arrList = site->live; arrList != NULL; arrList = arrList->nextAtSite) {
+			list_Stats stats = arrList->stats;
+			// the slack of a view is that of its root, and the slack of an
+			// array shared with snapshots is that of the list writing it
+			stats.slack = arrList->superList == NULL && !arrList->readOnly
+					? arrList->maxSize - arrList->size : 0;
+			mergeStats(&total->stats, &stats);
+			++total->live;
+		}
+		mergeStats(&all.stats, &total->stats);
+		all.lists += total->lists;
+		all.live += total->live;
+	}
+	pthread_mutex_unlock(&statsLock);
+	qsort(totals, count, sizeof(SiteTotal), compareSiteTotals);
+	dumpLine(fd, NULL, -1, all.lists, all.live, &all.stats);
+	for (i = 0; i < count; ++i)
+		if (totals[i].lists > 0)
+			dumpLine(fd, totals[i].site->file, totals[i].site->line,
+					totals[i].lists, totals[i].live, &totals[i].stats);
+	free(totals);
+#else
+	dprintf(fd, "list statistics are disabled, build with -DCOLLECTION_STATS\n");
+#endif
+}
+
+
+
+// Iteration
+
+/**
+ * Calls <tt>action</tt> on each element of this list in order, until it
+ * returns <tt>false</tt>.  Nothing is allocated or copied.  The behavior
+ * is undefined if the list is structurally modified by the action.
+ *
+ * @param action the function called on each element
+ * @param context passed through to every call of <tt>action</tt>
+ * @return <tt>true</tt> if every element was visited
+ */
+bool list_forEach(list_List list, list_Consumer action, void* context) {
+	ArrayList* arrList = syncView(list);
+	for (int64_t i = 0; i < arrList->size; ++i)
+		if (!action(arrList->array[i], context))
+			return false;
+	return true;
+}
+
+/**
+ * Advances a cursor over the elements of this list one contiguous span of
+ * the backing storage at a time.  Start with <tt>*position</tt> set to 0
+ * and call repeatedly; each call points <tt>*data</tt> at the next run of
+ * consecutive elements, in list order, and advances <tt>*position</tt>
+ * past it.  For a view the spans cover only the view.  The slots must not
+ * be written through <tt>*data</tt>, and the behavior is undefined if the
+ * list is structurally modified during the iteration.  Nothing is
+ * allocated or copied.
+ *
+ * @param position index of the next element to return, 0 to start
+ * @param data receives the address of the first element of the span
+ * @return the number of elements in the span, 0 once the end of the list
+ * is reached
+ */
+size_t list_nextSpan(list_List list, int64_t* position, void* const** data) {
+	ArrayList* arrList = syncView(list);
+	assert(*position >= 0 && *position <= arrList->size);
+	size_t length = arrList->size - *position;
+	*data = arrList->array + *position;
+	*position = arrList->size;
+	return length;
 }
 
 
@@ -621,11 +2339,20 @@ int64_t list_lastIndexOf(list_List list, void* o) {
  * <tt>lastIndexOf</tt>, and all of the algorithms in the
  * <tt>Collections</tt> class can be applied to a subList.<p>
  *
- * The semantics of the list returned by this method become undefined if
- * the backing list (i.e., this list) is <i>structurally modified</i> in
- * any way other than via the returned list.  (Structural modifications are
- * those that change the size of this list, or otherwise perturb it in such
- * a fashion that iterations in progress may yield incorrect results.)
+ * The view is an offset and a length into this list, so creating it
+ * costs O(1) and copies nothing.  Structural changes made through the
+ * view are applied to this list with a single block move of the elements
+ * that follow the view, and are reflected in the sizes of this list and
+ * of the views it is itself part of.  Operations on the view, such as
+ * <tt>clear</tt>, <tt>sort</tt> or <tt>indexOf</tt>, cost only the length
+ * of the view plus, for structural changes, that move.<p>
+ *
+ * If the backing list (i.e., this list) is <i>structurally modified</i>
+ * in any way other than via the returned list, using the returned list
+ * afterwards fails an assertion; it may still be deleted.  (Structural
+ * modifications are those that change the size of this list, or
+ * otherwise perturb it in such a fashion that iterations in progress may
+ * yield incorrect results.)
  *
  * @param fromIndex low endpoint64_t (inclusive) of the subList
  * @param toIndex high endpoint64_t (exclusive) of the subList
@@ -635,14 +2362,28 @@ int64_t list_lastIndexOf(list_List list, void* o) {
  * fromIndex &gt; toIndex</tt>)
  */
 list_List list_subList(list_List list, int64_t fromIndex, int64_t toIndex) {
-	ArrayList* arrList = (ArrayList*) list;
+	ArrayList* arrList = syncView(list);
 	assert(fromIndex >= 0 && toIndex <= arrList->size && toIndex >= fromIndex);
+	const collection_Allocator* allocator = arrList->allocator;
 	ArrayList* result = NULL;
-	result = malloc(sizeof(ArrayList));
+	result = allocator->allocate(allocator->context, sizeof(ArrayList));
+	assert(result != NULL);
 	result->array = arrList->array + fromIndex;
-	result->size = fromIndex - toIndex + 1;
-	result->maxSize = arrList->maxSize - fromIndex + 1;
+	result->size = toIndex - fromIndex;
+	result->maxSize = 0;
+	result->offset = arrList->offset + fromIndex;
 	result->superList = list;
+	result->root = arrList->root;
+	result->modCount = arrList->root->modCount;
+	result->orderCount = arrList->root->orderCount;
+	result->growthFactor = arrList->growthFactor;
+	result->growthIncrement = arrList->growthIncrement;
+	result->allocator = allocator;
+	result->comparator = arrList->comparator;
+	result->shareCount = NULL;
+	result->readOnly = arrList->readOnly;
+	result->hasInlineStorage = false;
+	STATS(registerList(result, arrList->site));
 	return (list_List) result;
 }
 
@@ -0,0 +1,740 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+
+#include "collection/allocator.h"
+
+#define LIST_IMPLEMENTATION concurrent
+#include "collection/list/implementations/concurrentlist.h"
+#include "multiset.h"
+
+/*
+ * Segmented vector.  Segment k holds 2^(k + FIRST_SHIFT) slots, so index i
+ * lives in the segment given by the highest set bit of i + 2^FIRST_SHIFT
+ * and the table of segments never has to grow.  A segment is allocated by
+ * the first producer that needs it and published with a compare-and-swap;
+ * a producer that loses the race frees its copy.
+ *
+ * Each slot has a ready flag set once its element is written.  reserved
+ * counts the slots handed out by fetch-add and size is the watermark below
+ * which every slot is ready.  After writing, a producer advances size over
+ * the run of ready slots that follows it, so a producer that stalls holds
+ * back what readers see but never blocks other producers.  The ready flags
+ * and the watermark are sequentially consistent: of two producers finishing
+ * out of order, at least one sees the flag of the other and carries the
+ * watermark past both.
+ */
+
+#define FIRST_SHIFT 4
+#define SEGMENT_COUNT (64 - FIRST_SHIFT)
+
+typedef struct Segment {
+	atomic_bool* ready; // one flag per slot, stored after the slots
+	_Atomic(void*) slots[];
+} Segment;
+
+typedef struct ConcurrentList {
+	_Atomic(Segment*) segments[SEGMENT_COUNT];
+	_Atomic int64_t reserved;
+	_Atomic int64_t size;
+	const collection_Allocator* allocator;
+} ConcurrentList;
+
+static int64_t segmentLength(int segment) {
+	return (int64_t) 1 << (segment + FIRST_SHIFT);
+}
+
+static size_t segmentBytes(int segment) {
+	return sizeof(Segment) + (sizeof(_Atomic(void*)) + sizeof(atomic_bool)) * segmentLength(segment);
+}
+
+static int segmentOf(int64_t index, int64_t* offset) {
+	uint64_t position = (uint64_t) index + ((uint64_t) 1 << FIRST_SHIFT);
+	int high = 63 - __builtin_clzll(position);
+	*offset = (int64_t) (position - ((uint64_t) 1 << high));
+	return high - FIRST_SHIFT;
+}
+
+/*
+ * Returns the slot of a published element.
+ */
+static _Atomic(void*)* slotAt(ConcurrentList* list, int64_t index) {
+	int64_t offset;
+	int segment = segmentOf(index, &offset);
+	Segment* s = atomic_load_explicit(&list->segments[segment], memory_order_acquire);
+	return &s->slots[offset];
+}
+
+static Segment* ensureSegment(ConcurrentList* list, int segment) {
+	Segment* s = atomic_load_explicit(&list->segments[segment], memory_order_acquire);
+	if (s != NULL)
+		return s;
+	const collection_Allocator* allocator = list->allocator;
+	int64_t length = segmentLength(segment);
+	Segment* fresh = allocator->allocate(allocator->context, segmentBytes(segment));
+	assert(fresh != NULL);
+	fresh->ready = (atomic_bool*) (fresh->slots + length);
+	for (int64_t i = 0; i < length; ++i)
+		atomic_init(&fresh->ready[i], false);
+	if (atomic_compare_exchange_strong_explicit(&list->segments[segment], &s, fresh,
+			memory_order_acq_rel, memory_order_acquire))
+		return fresh;
+	allocator->deallocate(allocator->context, fresh, segmentBytes(segment));
+	return s;
+}
+
+static void writeSlot(ConcurrentList* list, int64_t index, void* e) {
+	int64_t offset;
+	int segment = segmentOf(index, &offset);
+	Segment* s = ensureSegment(list, segment);
+	atomic_store_explicit(&s->slots[offset], e, memory_order_relaxed);
+	atomic_store(&s->ready[offset], true);
+}
+
+static bool isReady(ConcurrentList* list, int64_t index) {
+	int64_t offset;
+	int segment = segmentOf(index, &offset);
+	Segment* s = atomic_load_explicit(&list->segments[segment], memory_order_acquire);
+	return s != NULL && atomic_load(&s->ready[offset]);
+}
+
+/*
+ * Advances size over every ready slot that follows it.
+ */
+static void publish(ConcurrentList* list) {
+	int64_t size = atomic_load(&list->size);
+	for (;;) {
+		int64_t reserved = atomic_load(&list->reserved);
+		int64_t end = size;
+		while (end < reserved && isReady(list, end))
+			++end;
+		if (end == size)
+			return;
+		if (atomic_compare_exchange_weak(&list->size, &size, end))
+			size = end;
+	}
+}
+
+static void freeSegments(ConcurrentList* list) {
+	const collection_Allocator* allocator = list->allocator;
+	for (int i = 0; i < SEGMENT_COUNT; ++i) {
+		Segment* s = atomic_load_explicit(&list->segments[i], memory_order_relaxed);
+		if (s != NULL)
+			allocator->deallocate(allocator->context, s, segmentBytes(i));
+		atomic_init(&list->segments[i], NULL);
+	}
+}
+
+/*
+ * Fails a call of an operation the list does not support.  Aborts rather
+ * than asserts, so that a build with NDEBUG does not drop or invent
+ * elements instead.
+ */
+__attribute__((noreturn))
+static void unsupported(const char* operation) {
+	fprintf(stderr, "%s is not supported by the concurrent list\n", operation);
+	abort();
+}
+
+list_List list_newList() {
+	return list_newListWithAllocator(&collection_stdAllocator);
+}
+
+/**
+ * Constructs an empty list whose header, backing array and any scratch
+ * memory used by its operations are obtained from <tt>allocator</tt>.
+ * Arrays returned by {@link #toArray} are still allocated with
+ * <tt>malloc</tt> since their ownership passes to the caller.
+ *
+ * @param allocator allocator that must outlive the list
+ * @return the new list
+ */
+list_List list_newListWithAllocator(const collection_Allocator* allocator) {
+	ConcurrentList* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(ConcurrentList));
+	assert(result != NULL);
+	for (int i = 0; i < SEGMENT_COUNT; ++i)
+		atomic_init(&result->segments[i], NULL);
+	atomic_init(&result->reserved, 0);
+	atomic_init(&result->size, 0);
+	result->allocator = allocator;
+	return (list_List) result;
+}
+
+bool list_delList(list_List list) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	const collection_Allocator* allocator = concurrent->allocator;
+	freeSegments(concurrent);
+	allocator->deallocate(allocator->context, concurrent, sizeof(ConcurrentList));
+	return true;
+}
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of elements in this list.  If this list contains
+ * more than <tt>Integer.MAX_VALUE</tt> elements, returns
+ * <tt>Integer.MAX_VALUE</tt>.
+ *
+ * @return the number of elements in this list
+ */
+int64_t list_size(list_List list) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	return atomic_load_explicit(&concurrent->size, memory_order_acquire);
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains no elements.
+ *
+ * @return <tt>true</tt> if this list contains no elements
+ */
+bool list_isEmpty(list_List list) {
+	return list_size(list) == 0;
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains the specified element.
+ * More formally, returns <tt>true</tt> if and only if this list contains
+ * at least one element <tt>e</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;e==null&nbsp;:&nbsp;o.equals(e))</tt>.
+ *
+ * @param o element whose presence in this list is to be tested
+ * @return <tt>true</tt> if this list contains the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+bool list_contains(list_List list, void* o) {
+	return list_indexOf(list, o) >= 0;
+}
+
+/**
+ * Returns an array containing all of the elements in this list in proper
+ * sequence (from first to last element).
+ *
+ * <p>The returned array will be "safe" in that no references to it are
+ * maint64_tained by this list.  (In other words, this method must
+ * allocate a new array even if this list is backed by an array).
+ * The caller is thus free to modify the returned array.
+ *
+ * <p>This method acts as bridge between array-based and collection-based
+ * APIs.
+ *
+ * @return an array containing all of the elements in this list in proper
+ * sequence
+ */
+void** list_toArray(list_List list) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	int64_t size = list_size(list);
+	void** result = NULL;
+	result = malloc(sizeof(void*) * (size > 0 ? size : 1));
+	assert(result != NULL);
+	for (int64_t i = 0; i < size; ++i)
+		result[i] = atomic_load_explicit(slotAt(concurrent, i), memory_order_acquire);
+	return result;
+}
+
+
+
+// Modification Operations
+
+/**
+ * Appends the specified element to the end of this list (optional
+ * operation).
+ *
+ * <p>Lists that support this operation may place limitations on what
+ * elements may be added to this list.  In particular, some
+ * lists will refuse to add null elements, and others will impose
+ * restrictions on the type of elements that may be added.  List
+ * classes should clearly specify in their documentation any restrictions
+ * on what elements may be added.
+ *
+ * @param e element to be appended to this list
+ * @return <tt>true</tt> (as specified by {@link Collection#add})
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements
+ * @throws IllegalArgumentException if some property of this element
+ * prevents it from being added to this list
+ */
+bool list_add(list_List list, void* e) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	int64_t index = atomic_fetch_add_explicit(&concurrent->reserved, 1, memory_order_relaxed);
+	writeSlot(concurrent, index, e);
+	publish(concurrent);
+	return true;
+}
+
+/**
+ * Removes the first occurrence of the specified element from this list,
+ * if it is present (optional operation).  If this list does not contain
+ * the element, it is unchanged.  More formally, removes the element with
+ * the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>
+ * (if such an element exists).  Returns <tt>true</tt> if this list
+ * contained the specified element (or equivalently, if this list changed
+ * as a result of the call).
+ *
+ * @param o element to be removed from this list, if present
+ * @return <tt>true</tt> if this list contained the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ */
+bool list_remove(list_List list, void* o) {
+	unsupported("remove");
+}
+
+
+
+// Bulk Modification Operations
+
+/**
+ * Returns <tt>true</tt> if this list contains all of the elements of the
+ * specified collection.
+ *
+ * @param  c collection to be checked for containment in this list
+ * @return <tt>true</tt> if this list contains all of the elements of the
+ * specified collection
+ * @throws ClassCastException if the types of one or more elements
+ * in the specified collection are incompatible with this
+ * list (optional)
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements (optional), or if the specified collection is null
+ * @see #contains(void*)
+ */
+bool list_containsAll(list_List list, void* arr[], size_t arrLength) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	int64_t size = list_size(list);
+	if (arrLength > (size_t) size)
+		return false;
+	Multiset set;
+	multisetInit(&set, concurrent->allocator, arr, arrLength);
+	// each list element may satisfy at most one occurrence in arr
+	size_t remaining = arrLength;
+	for (int64_t i = 0; i < size && remaining > 0; ++i)
+		if (multisetTake(&set, atomic_load_explicit(slotAt(concurrent, i), memory_order_acquire)))
+			--remaining;
+	multisetFree(&set);
+	return remaining == 0;
+}
+
+/**
+ * Appends all of the elements in the specified collection to the end of
+ * this list, in the order that they are returned by the specified
+ * collection's iterator (optional operation).  The behavior of this
+ * operation is undefined if the specified collection is modified while
+ * the operation is in progress.  (Note that this will occur if the
+ * specified collection is this list, and it's nonempty.)
+ *
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @see #add(void*)
+ */
+bool list_addAll(list_List list, void* arr[], size_t arrLength) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	if (arrLength == 0)
+		return false;
+	int64_t index = atomic_fetch_add_explicit(&concurrent->reserved, arrLength, memory_order_relaxed);
+	for (size_t i = 0; i < arrLength; ++i)
+		writeSlot(concurrent, index + i, arr[i]);
+	publish(concurrent);
+	return true;
+}
+
+/**
+ * Inserts all of the elements in the specified collection int64_to this
+ * list at the specified position (optional operation).  Shifts the
+ * element currently at that position (if any) and any subsequent
+ * elements to the right (increases their indices).  The new elements
+ * will appear in this list in the order that they are returned by the
+ * specified collection's iterator.  The behavior of this operation is
+ * undefined if the specified collection is modified while the
+ * operation is in progress.  (Note that this will occur if the specified
+ * collection is this list, and it's nonempty.)
+ *
+ * @param index index at which to insert the first element from the
+ *  specified collection
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+bool list_addAllAt(list_List list, int64_t index, void* arr[], size_t arrLength) {
+	unsupported("addAllAt");
+}
+
+/**
+ * Removes from this list all of its elements that are contained in the
+ * specified collection (optional operation).
+ *
+ * @param c collection containing elements to be removed from this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>removeAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_removeAll(list_List list, void* arr[], size_t arrLength) {
+	unsupported("removeAll");
+}
+
+/**
+ * Retains only the elements in this list that are contained in the
+ * specified collection (optional operation).  In other words, removes
+ * from this list all of its elements that are not contained in the
+ * specified collection.
+ *
+ * @param c collection containing elements to be retained in this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>retainAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_retainAll(list_List list, void* arr[], size_t arrLength) {
+	unsupported("retainAll");
+}
+
+/**
+ * Removes all of the elements from this list (optional operation).
+ * The list will be empty after this call returns.
+ *
+ * @throws UnsupportedOperationException if the <tt>clear</tt> operation
+ * is not supported by this list
+ */
+void list_clear(list_List list) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	freeSegments(concurrent);
+	atomic_store(&concurrent->reserved, 0);
+	atomic_store(&concurrent->size, 0);
+}
+
+
+
+// Comparison and hashing
+
+/**
+ * Compares the specified object with this list for equality.  Returns
+ * <tt>true</tt> if and only if the specified object is also a list, both
+ * lists have the same size, and all corresponding pairs of elements in
+ * the two lists are <i>equal</i>.  (Two elements <tt>e1</tt> and
+ * <tt>e2</tt> are <i>equal</i> if <tt>(e1==null ? e2==null :
+ * e1.equals(e2))</tt>.)  In other words, two lists are defined to be
+ * equal if they contain the same elements in the same order.  This
+ * definition ensures that the equals method works properly across
+ * different implementations of the <tt>List</tt> int64_terface.
+ *
+ * @param o the object to be compared for equality with this list
+ * @return <tt>true</tt> if the specified object is equal to this list
+ */
+bool list_equals(list_List list, list_List o) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	ConcurrentList* concurrent2 = (ConcurrentList*) o;
+	int64_t size = list_size(list);
+	if (size != list_size(o))
+		return false;
+	for (int64_t i = 0; i < size; ++i)
+		if (atomic_load_explicit(slotAt(concurrent, i), memory_order_acquire)
+				!= atomic_load_explicit(slotAt(concurrent2, i), memory_order_acquire))
+			return false;
+	return true;
+}
+
+
+
+// Positional Access Operations
+
+/**
+ * Returns the element at the specified position in this list.
+ *
+ * @param index index of the element to return
+ * @return the element at the specified position in this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_get(list_List list, int64_t index) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	assert(index >= 0 && index < list_size(list));
+	return atomic_load_explicit(slotAt(concurrent, index), memory_order_acquire);
+}
+
+/**
+ * Replaces the element at the specified position in this list with the
+ * specified element (optional operation).
+ *
+ * @param index index of the element to replace
+ * @param element element to be stored at the specified position
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>set</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_set(list_List list, int64_t index, void* element) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	assert(index >= 0 && index < list_size(list));
+	return atomic_exchange_explicit(slotAt(concurrent, index), element, memory_order_acq_rel);
+}
+
+/**
+ * Inserts the specified element at the specified position in this list
+ * (optional operation).  Shifts the element currently at that position
+ * (if any) and any subsequent elements to the right (adds one to their
+ * indices).
+ *
+ * @param index index at which the specified element is to be inserted
+ * @param element element to be inserted
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+void list_addAt(list_List list, int64_t index, void* element) {
+	unsupported("addAt");
+}
+
+/**
+ * Removes the element at the specified position in this list (optional
+ * operation).  Shifts any subsequent elements to the left (subtracts one
+ * from their indices).  Returns the element that was removed from the
+ * list.
+ *
+ * @param index the index of the element to be removed
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_removeAt(list_List list, int64_t index) {
+	unsupported("removeAt");
+}
+
+
+
+// Search Operations
+
+/**
+ * Returns the index of the first occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the first occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_indexOf(list_List list, void* o) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	int64_t size = list_size(list);
+	for (int64_t i = 0; i < size; ++i)
+		if (atomic_load_explicit(slotAt(concurrent, i), memory_order_acquire) == o)
+			return i;
+	return -1;
+}
+
+/**
+ * Returns the index of the last occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the highest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the last occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_lastIndexOf(list_List list, void* o) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	for (int64_t i = list_size(list) - 1; i >= 0; --i)
+		if (atomic_load_explicit(slotAt(concurrent, i), memory_order_acquire) == o)
+			return i;
+	return -1;
+}
+
+
+
+// Iteration
+
+/**
+ * Calls <tt>action</tt> on each element of this list in order, until it
+ * returns <tt>false</tt>.  Nothing is allocated or copied.  The behavior
+ * is undefined if the list is structurally modified by the action.
+ *
+ * @param action the function called on each element
+ * @param context passed through to every call of <tt>action</tt>
+ * @return <tt>true</tt> if every element was visited
+ */
+bool list_forEach(list_List list, list_Consumer action, void* context) {
+	int64_t position = 0;
+	void* const* data;
+	size_t length;
+	while ((length = list_nextSpan(list, &position, &data)) > 0)
+		for (size_t i = 0; i < length; ++i)
+			if (!action(data[i], context))
+				return false;
+	return true;
+}
+
+/**
+ * Advances a cursor over the elements of this list one contiguous span of
+ * the backing storage at a time.  Start with <tt>*position</tt> set to 0
+ * and call repeatedly; each call points <tt>*data</tt> at the next run of
+ * consecutive elements, in list order, and advances <tt>*position</tt>
+ * past it.  For a view the spans cover only the view.  The slots must not
+ * be written through <tt>*data</tt>, and the behavior is undefined if the
+ * list is structurally modified during the iteration.  Nothing is
+ * allocated or copied.
+ *
+ * @param position index of the next element to return, 0 to start
+ * @param data receives the address of the first element of the span
+ * @return the number of elements in the span, 0 once the end of the list
+ * is reached
+ */
+size_t list_nextSpan(list_List list, int64_t* position, void* const** data) {
+	ConcurrentList* concurrent = (ConcurrentList*) list;
+	int64_t size = list_size(list);
+	assert(*position >= 0);
+	if (*position >= size)
+		return 0;
+	int64_t offset;
+	int segment = segmentOf(*position, &offset);
+	Segment* s = atomic_load_explicit(&concurrent->segments[segment], memory_order_acquire);
+	int64_t length = segmentLength(segment) - offset;
+	if (length > size - *position)
+		length = size - *position;
+	*data = (void* const*) &s->slots[offset];
+	*position += length;
+	return length;
+}
+
+
+
+// View
+
+/**
+ * Returns a view of the portion of this list between the specified
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  (If
+ * <tt>fromIndex</tt> and <tt>toIndex</tt> are equal, the returned list is
+ * empty.)  The returned list is backed by this list, so non-structural
+ * changes in the returned list are reflected in this list, and vice-versa.
+ * The returned list supports all of the optional list operations supported
+ * by this list.<p>
+ *
+ * This method eliminates the need for explicit range operations (of
+ * the sort that commonly exist for arrays).  Any operation that expects
+ * a list can be used as a range operation by passing a subList view
+ * instead of a whole list.  For example, the following idiom
+ * removes a range of elements from a list:
+ * <pre>
+ *  list.subList(from, to).clear();
+ * </pre>
+ * Similar idioms may be constructed for <tt>indexOf</tt> and
+ * <tt>lastIndexOf</tt>, and all of the algorithms in the
+ * <tt>Collections</tt> class can be applied to a subList.<p>
+ *
+ * The semantics of the list returned by this method become undefined if
+ * the backing list (i.e., this list) is <i>structurally modified</i> in
+ * any way other than via the returned list.  (Structural modifications are
+ * those that change the size of this list, or otherwise perturb it in such
+ * a fashion that iterations in progress may yield incorrect results.)
+ *
+ * @param fromIndex low endpoint64_t (inclusive) of the subList
+ * @param toIndex high endpoint64_t (exclusive) of the subList
+ * @return a view of the specified range within this list
+ * @throws IndexOutOfBoundsException for an illegal endpoint64_t index value
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size ||
+ * fromIndex &gt; toIndex</tt>)
+ */
+list_List list_subList(list_List list, int64_t fromIndex, int64_t toIndex) {
+	unsupported("subList");
+}
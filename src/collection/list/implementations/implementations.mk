@@ -3,9 +3,25 @@ abort:   ## This MUST be the first target :( ugly
 	@echo Make must be run from the root of the project && false
 endif
 
-export IMPLEMENTATIONS_OBJ:= implementations/arraylist.o
+all: arraylist.o typedlist.o arraydeque.o tieredlist.o concurrentlist.o syncarraylist.o synchronizedlist.o
 
-all: $(IMPLEMENTATIONS_OBJ:implementations=)
+arraylist.o: $(BASE_DIR)/include/collection/list/implementations/arraylist.h $(BASE_DIR)/include/collection/list/implementations/arraylistlayout.h multiset.h arraylist.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include arraylist.c
 
-arraylist.o: ../list.h arraylist.c
-        gcc -c -Wall -fpic arraylist.c
+typedlist.o: $(BASE_DIR)/include/collection/list/implementations/typedlist.h $(BASE_DIR)/include/collection/recordfile.h typedlist.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include typedlist.c
+
+arraydeque.o: $(BASE_DIR)/include/collection/list/implementations/arraydeque.h multiset.h arraydeque.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include arraydeque.c
+
+tieredlist.o: $(BASE_DIR)/include/collection/list/implementations/tieredlist.h multiset.h tieredlist.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include tieredlist.c
+
+concurrentlist.o: $(BASE_DIR)/include/collection/list/implementations/concurrentlist.h multiset.h concurrentlist.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include concurrentlist.c
+
+syncarraylist.o: $(BASE_DIR)/include/collection/list/implementations/arraylist.h $(BASE_DIR)/include/collection/list/implementations/arraylistlayout.h multiset.h arraylist.c syncarraylist.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include syncarraylist.c
+
+synchronizedlist.o: $(BASE_DIR)/include/collection/list/implementations/synchronizedlist.h $(BASE_DIR)/include/collection/list/implementations/arraylistlayout.h $(BASE_DIR)/include/collection/epoch.h synchronizedlist.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include synchronizedlist.c
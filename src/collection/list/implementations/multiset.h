@@ -0,0 +1,103 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "collection/allocator.h"
+
+#ifndef MULTISET_H
+#define MULTISET_H
+
+/*
+ * Scratch multiset of pointers used by the bulk operations of the list
+ * implementations.  Open addressing with linear probing over a power of
+ * two table; a slot keeps its key once used so that counts which drop to
+ * zero are still found.
+ */
+typedef struct {
+	void* key;
+	size_t count;
+	bool used;
+} MultisetEntry;
+
+typedef struct {
+	MultisetEntry* table;
+	size_t mask;
+	const collection_Allocator* allocator;
+} Multiset;
+
+static inline size_t hashPointer(void* p) {
+	uint64_t h = (uint64_t) (uintptr_t) p;
+	h ^= h >> 33;
+	h *= UINT64_C(0xff51afd7ed558ccd);
+	h ^= h >> 33;
+	return (size_t) h;
+}
+
+static inline MultisetEntry* multisetFind(Multiset* set, void* key) {
+	size_t i = hashPointer(key) & set->mask;
+	while (set->table[i].used && set->table[i].key != key)
+		i = (i + 1) & set->mask;
+	return &set->table[i];
+}
+
+static inline void multisetInit(Multiset* set, const collection_Allocator* allocator,
+		void* arr[], size_t arrLength) {
+	size_t tableSize = 16;
+	while (tableSize < arrLength * 2)
+		tableSize <<= 1;
+	set->table = allocator->allocate(allocator->context, sizeof(MultisetEntry) * tableSize);
+	assert(set->table != NULL);
+	memset(set->table, 0, sizeof(MultisetEntry) * tableSize);
+	set->mask = tableSize - 1;
+	set->allocator = allocator;
+	for (size_t i = 0; i < arrLength; ++i) {
+		MultisetEntry* entry = multisetFind(set, arr[i]);
+		entry->key = arr[i];
+		entry->used = true;
+		++entry->count;
+	}
+}
+
+/*
+ * Consumes one occurrence of key.  Returns false if none are left.
+ */
+static inline bool multisetTake(Multiset* set, void* key) {
+	MultisetEntry* entry = multisetFind(set, key);
+	if (entry->count == 0)
+		return false;
+	--entry->count;
+	return true;
+}
+
+static inline void multisetFree(Multiset* set) {
+	set->allocator->deallocate(set->allocator->context, set->table,
+			sizeof(MultisetEntry) * (set->mask + 1));
+}
+
+#endif
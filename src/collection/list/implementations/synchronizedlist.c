@@ -0,0 +1,784 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "collection/allocator.h"
+#include "collection/epoch.h"
+
+#define LIST_IMPLEMENTATION synchronized
+#include "collection/list/implementations/synchronizedlist.h"
+#include "collection/list/implementations/arraylistlayout.h"
+
+/*
+ * An ArrayList behind a sequence lock.  A writer takes the mutex and makes
+ * the sequence odd while it calls into the array list.  A reader notes an
+ * even sequence, reads the header and the elements of the array list with
+ * atomic loads, and retries if the sequence has moved since.  The array
+ * and the size are checked against the sequence before any element is
+ * read, so the bounds a reader uses always belong to the array it reads.
+ * The array list is the syncarray build of arraylist.c, whose stores to
+ * the array, the size and the slots are atomic as well, so readers and
+ * the writer never race.
+ *
+ * A writer may replace the array while a reader still holds the old one.
+ * The array list is therefore given an allocator that retires every block
+ * it frees to an epoch domain, and readers stay inside a critical section
+ * of the domain, so the old array is only deallocated once no reader can
+ * still be reading it.
+ */
+
+// the array list operations the writers delegate to
+#define ARRAY(name) LIST_NAME_OF(syncarray, name)
+list_List ARRAY(newListWithAllocator)(const collection_Allocator* allocator);
+bool ARRAY(delList)(list_List);
+bool ARRAY(add)(list_List, void* e);
+bool ARRAY(remove)(list_List, void* o);
+bool ARRAY(containsAll)(list_List, void* arr[], size_t arrLength);
+bool ARRAY(addAll)(list_List, void* arr[], size_t arrLength);
+bool ARRAY(addAllAt)(list_List, int64_t index, void* arr[], size_t arrLength);
+bool ARRAY(removeAll)(list_List, void* arr[], size_t arrLength);
+bool ARRAY(retainAll)(list_List, void* arr[], size_t arrLength);
+void ARRAY(clear)(list_List);
+void* ARRAY(set)(list_List, int64_t index, void* element);
+void ARRAY(addAt)(list_List, int64_t index, void* element);
+void* ARRAY(removeAt)(list_List, int64_t index);
+bool ARRAY(forEach)(list_List, list_Consumer action, void* context);
+list_List ARRAY(snapshot)(list_List);
+
+typedef struct SynchronizedList {
+	_Atomic uint64_t sequence; // odd while a writer is modifying the list
+	array_list_Layout* list;
+	collection_EpochDomain* domain;
+	const collection_Allocator* allocator;
+	collection_Allocator retiring; // given to the array list, with this list as context
+	pthread_mutex_t lock; // held by writers
+} SynchronizedList;
+
+static void* retiringAllocate(void* context, size_t size) {
+	SynchronizedList* sync = context;
+	return sync->allocator->allocate(sync->allocator->context, size);
+}
+
+/*
+ * Always moves the block, since readers may still be reading the old one.
+ */
+static void* retiringReallocate(void* context, void* ptr, size_t oldSize, size_t newSize) {
+	SynchronizedList* sync = context;
+	void* result = retiringAllocate(context, newSize);
+	if (result != NULL && ptr != NULL) {
+		memcpy(result, ptr, oldSize < newSize ? oldSize : newSize);
+		collection_epochRetire(sync->domain, ptr, oldSize);
+	}
+	return result;
+}
+
+static void retiringDeallocate(void* context, void* ptr, size_t size) {
+	SynchronizedList* sync = context;
+	if (ptr != NULL)
+		collection_epochRetire(sync->domain, ptr, size);
+}
+
+/*
+ * Fails a call of an operation the list does not support.  Aborts rather
+ * than asserts, so that a build with NDEBUG fails loudly too.
+ */
+__attribute__((noreturn))
+static void unsupported(const char* operation) {
+	fprintf(stderr, "%s is not supported by the synchronized list\n", operation);
+	abort();
+}
+
+static void beginWrite(SynchronizedList* sync) {
+	pthread_mutex_lock(&sync->lock);
+	uint64_t sequence = atomic_load_explicit(&sync->sequence, memory_order_relaxed);
+	atomic_store_explicit(&sync->sequence, sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+}
+
+static void endWrite(SynchronizedList* sync) {
+	uint64_t sequence = atomic_load_explicit(&sync->sequence, memory_order_relaxed);
+	atomic_store_explicit(&sync->sequence, sequence + 1, memory_order_release);
+	pthread_mutex_unlock(&sync->lock);
+}
+
+/*
+ * Waits until no writer is modifying the list and returns the sequence to
+ * validate the reads against.
+ */
+static uint64_t beginRead(SynchronizedList* sync) {
+	uint64_t sequence;
+	while ((sequence = atomic_load_explicit(&sync->sequence, memory_order_acquire)) & 1)
+		sched_yield();
+	return sequence;
+}
+
+/*
+ * Returns true if no writer has run since beginRead returned sequence, in
+ * which case everything read in between is consistent.
+ */
+static bool validate(SynchronizedList* sync, uint64_t sequence) {
+	atomic_thread_fence(memory_order_acquire);
+	return atomic_load_explicit(&sync->sequence, memory_order_relaxed) == sequence;
+}
+
+/*
+ * Reads the array and size of the array list.  Returns false if they may
+ * not belong together, in which case the read must be retried.  The array
+ * is read with acquire semantics, pairing with the release store that
+ * publishes a new array, so the elements copied into it are visible.
+ */
+static bool readHeader(SynchronizedList* sync, uint64_t sequence, void*** array, int64_t* size) {
+	*array = __atomic_load_n(&sync->list->array, __ATOMIC_ACQUIRE);
+	*size = __atomic_load_n(&sync->list->size, __ATOMIC_RELAXED);
+	return validate(sync, sequence);
+}
+
+static void* readSlot(void** array, int64_t index) {
+	return __atomic_load_n(&array[index], __ATOMIC_RELAXED);
+}
+
+list_List list_newList() {
+	return list_newListWithAllocator(&collection_stdAllocator);
+}
+
+/**
+ * Constructs an empty list whose header, backing array and any scratch
+ * memory used by its operations are obtained from <tt>allocator</tt>.
+ * Arrays returned by {@link #toArray} are still allocated with
+ * <tt>malloc</tt> since their ownership passes to the caller.
+ *
+ * @param allocator allocator that must outlive the list
+ * @return the new list
+ */
+list_List list_newListWithAllocator(const collection_Allocator* allocator) {
+	SynchronizedList* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(SynchronizedList));
+	assert(result != NULL);
+	atomic_init(&result->sequence, 0);
+	result->domain = collection_newEpochDomain(allocator);
+	result->allocator = allocator;
+	result->retiring.allocate = retiringAllocate;
+	result->retiring.reallocate = retiringReallocate;
+	result->retiring.deallocate = retiringDeallocate;
+	result->retiring.context = result;
+	pthread_mutex_init(&result->lock, NULL);
+	result->list = ARRAY(newListWithAllocator)(&result->retiring);
+	return (list_List) result;
+}
+
+bool list_delList(list_List list) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	const collection_Allocator* allocator = sync->allocator;
+	ARRAY(delList)(sync->list);
+	collection_delEpochDomain(sync->domain);
+	pthread_mutex_destroy(&sync->lock);
+	allocator->deallocate(allocator->context, sync, sizeof(SynchronizedList));
+	return true;
+}
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of elements in this list.  If this list contains
+ * more than <tt>Integer.MAX_VALUE</tt> elements, returns
+ * <tt>Integer.MAX_VALUE</tt>.
+ *
+ * @return the number of elements in this list
+ */
+int64_t list_size(list_List list) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	int64_t size;
+	uint64_t sequence;
+	do {
+		sequence = beginRead(sync);
+		size = __atomic_load_n(&sync->list->size, __ATOMIC_RELAXED);
+	} while (!validate(sync, sequence));
+	return size;
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains no elements.
+ *
+ * @return <tt>true</tt> if this list contains no elements
+ */
+bool list_isEmpty(list_List list) {
+	return list_size(list) == 0;
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains the specified element.
+ * More formally, returns <tt>true</tt> if and only if this list contains
+ * at least one element <tt>e</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;e==null&nbsp;:&nbsp;o.equals(e))</tt>.
+ *
+ * @param o element whose presence in this list is to be tested
+ * @return <tt>true</tt> if this list contains the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+bool list_contains(list_List list, void* o) {
+	return list_indexOf(list, o) >= 0;
+}
+
+/**
+ * Returns an array containing all of the elements in this list in proper
+ * sequence (from first to last element).
+ *
+ * <p>The returned array will be "safe" in that no references to it are
+ * maint64_tained by this list.  (In other words, this method must
+ * allocate a new array even if this list is backed by an array).
+ * The caller is thus free to modify the returned array.
+ *
+ * <p>This method acts as bridge between array-based and collection-based
+ * APIs.
+ *
+ * @return an array containing all of the elements in this list in proper
+ * sequence
+ */
+void** list_toArray(list_List list) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	void** result = NULL;
+	void** array;
+	int64_t size;
+	collection_epochEnter(sync->domain);
+	for (;;) {
+		uint64_t sequence = beginRead(sync);
+		if (!readHeader(sync, sequence, &array, &size))
+			continue;
+		result = realloc(result, sizeof(void*) * (size > 0 ? size : 1));
+		assert(result != NULL);
+		for (int64_t i = 0; i < size; ++i)
+			result[i] = readSlot(array, i);
+		if (validate(sync, sequence))
+			break;
+	}
+	collection_epochExit(sync->domain);
+	return result;
+}
+
+
+
+// Modification Operations
+
+/**
+ * Appends the specified element to the end of this list (optional
+ * operation).
+ *
+ * <p>Lists that support this operation may place limitations on what
+ * elements may be added to this list.  In particular, some
+ * lists will refuse to add null elements, and others will impose
+ * restrictions on the type of elements that may be added.  List
+ * classes should clearly specify in their documentation any restrictions
+ * on what elements may be added.
+ *
+ * @param e element to be appended to this list
+ * @return <tt>true</tt> (as specified by {@link Collection#add})
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements
+ * @throws IllegalArgumentException if some property of this element
+ * prevents it from being added to this list
+ */
+bool list_add(list_List list, void* e) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	bool result = ARRAY(add)(sync->list, e);
+	endWrite(sync);
+	return result;
+}
+
+/**
+ * Removes the first occurrence of the specified element from this list,
+ * if it is present (optional operation).  If this list does not contain
+ * the element, it is unchanged.  More formally, removes the element with
+ * the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>
+ * (if such an element exists).  Returns <tt>true</tt> if this list
+ * contained the specified element (or equivalently, if this list changed
+ * as a result of the call).
+ *
+ * @param o element to be removed from this list, if present
+ * @return <tt>true</tt> if this list contained the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ */
+bool list_remove(list_List list, void* o) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	bool result = ARRAY(remove)(sync->list, o);
+	endWrite(sync);
+	return result;
+}
+
+
+
+// Bulk Modification Operations
+
+/**
+ * Returns <tt>true</tt> if this list contains all of the elements of the
+ * specified collection.  Holds the writer mutex while it runs.
+ *
+ * @param  c collection to be checked for containment in this list
+ * @return <tt>true</tt> if this list contains all of the elements of the
+ * specified collection
+ * @throws ClassCastException if the types of one or more elements
+ * in the specified collection are incompatible with this
+ * list (optional)
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements (optional), or if the specified collection is null
+ * @see #contains(void*)
+ */
+bool list_containsAll(list_List list, void* arr[], size_t arrLength) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	pthread_mutex_lock(&sync->lock);
+	bool result = ARRAY(containsAll)(sync->list, arr, arrLength);
+	pthread_mutex_unlock(&sync->lock);
+	return result;
+}
+
+/**
+ * Appends all of the elements in the specified collection to the end of
+ * this list, in the order that they are returned by the specified
+ * collection's iterator (optional operation).  The behavior of this
+ * operation is undefined if the specified collection is modified while
+ * the operation is in progress.  (Note that this will occur if the
+ * specified collection is this list, and it's nonempty.)
+ *
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @see #add(void*)
+ */
+bool list_addAll(list_List list, void* arr[], size_t arrLength) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	bool result = ARRAY(addAll)(sync->list, arr, arrLength);
+	endWrite(sync);
+	return result;
+}
+
+/**
+ * Inserts all of the elements in the specified collection int64_to this
+ * list at the specified position (optional operation).  Shifts the
+ * element currently at that position (if any) and any subsequent
+ * elements to the right (increases their indices).  The new elements
+ * will appear in this list in the order that they are returned by the
+ * specified collection's iterator.  The behavior of this operation is
+ * undefined if the specified collection is modified while the
+ * operation is in progress.  (Note that this will occur if the specified
+ * collection is this list, and it's nonempty.)
+ *
+ * @param index index at which to insert the first element from the
+ *  specified collection
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+bool list_addAllAt(list_List list, int64_t index, void* arr[], size_t arrLength) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	bool result = ARRAY(addAllAt)(sync->list, index, arr, arrLength);
+	endWrite(sync);
+	return result;
+}
+
+/**
+ * Removes from this list all of its elements that are contained in the
+ * specified collection (optional operation).
+ *
+ * @param c collection containing elements to be removed from this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>removeAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_removeAll(list_List list, void* arr[], size_t arrLength) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	bool result = ARRAY(removeAll)(sync->list, arr, arrLength);
+	endWrite(sync);
+	return result;
+}
+
+/**
+ * Retains only the elements in this list that are contained in the
+ * specified collection (optional operation).  In other words, removes
+ * from this list all of its elements that are not contained in the
+ * specified collection.
+ *
+ * @param c collection containing elements to be retained in this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>retainAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_retainAll(list_List list, void* arr[], size_t arrLength) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	bool result = ARRAY(retainAll)(sync->list, arr, arrLength);
+	endWrite(sync);
+	return result;
+}
+
+/**
+ * Removes all of the elements from this list (optional operation).
+ * The list will be empty after this call returns.
+ *
+ * @throws UnsupportedOperationException if the <tt>clear</tt> operation
+ * is not supported by this list
+ */
+void list_clear(list_List list) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	ARRAY(clear)(sync->list);
+	endWrite(sync);
+}
+
+
+
+// Comparison and hashing
+
+/**
+ * Compares the specified object with this list for equality.  Returns
+ * <tt>true</tt> if and only if the specified object is also a list, both
+ * lists have the same size, and all corresponding pairs of elements in
+ * the two lists are <i>equal</i>.  (Two elements <tt>e1</tt> and
+ * <tt>e2</tt> are <i>equal</i> if <tt>(e1==null ? e2==null :
+ * e1.equals(e2))</tt>.)  In other words, two lists are defined to be
+ * equal if they contain the same elements in the same order.  This
+ * definition ensures that the equals method works properly across
+ * different implementations of the <tt>List</tt> int64_terface.  Both
+ * lists must be synchronized lists; each is read as of a moment no writer
+ * was modifying it.
+ *
+ * @param o the object to be compared for equality with this list
+ * @return <tt>true</tt> if the specified object is equal to this list
+ */
+bool list_equals(list_List list, list_List o) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	SynchronizedList* sync2 = (SynchronizedList*) o;
+	void** array;
+	void** array2;
+	int64_t size, size2;
+	bool result;
+	if (sync == sync2)
+		return true;
+	collection_epochEnter(sync->domain);
+	collection_epochEnter(sync2->domain);
+	for (;;) {
+		uint64_t sequence = beginRead(sync);
+		uint64_t sequence2 = beginRead(sync2);
+		if (!readHeader(sync, sequence, &array, &size)
+				|| !readHeader(sync2, sequence2, &array2, &size2))
+			continue;
+		result = size == size2;
+		for (int64_t i = 0; result && i < size; ++i)
+			result = readSlot(array, i) == readSlot(array2, i);
+		if (validate(sync, sequence) && validate(sync2, sequence2))
+			break;
+	}
+	collection_epochExit(sync2->domain);
+	collection_epochExit(sync->domain);
+	return result;
+}
+
+
+
+// Positional Access Operations
+
+/**
+ * Returns the element at the specified position in this list.
+ *
+ * @param index index of the element to return
+ * @return the element at the specified position in this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_get(list_List list, int64_t index) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	void** array;
+	int64_t size;
+	void* result;
+	collection_epochEnter(sync->domain);
+	for (;;) {
+		uint64_t sequence = beginRead(sync);
+		if (!readHeader(sync, sequence, &array, &size))
+			continue;
+		assert(index >= 0 && index < size);
+		result = readSlot(array, index);
+		if (validate(sync, sequence))
+			break;
+	}
+	collection_epochExit(sync->domain);
+	return result;
+}
+
+/**
+ * Replaces the element at the specified position in this list with the
+ * specified element (optional operation).
+ *
+ * @param index index of the element to replace
+ * @param element element to be stored at the specified position
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>set</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_set(list_List list, int64_t index, void* element) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	void* result = ARRAY(set)(sync->list, index, element);
+	endWrite(sync);
+	return result;
+}
+
+/**
+ * Inserts the specified element at the specified position in this list
+ * (optional operation).  Shifts the element currently at that position
+ * (if any) and any subsequent elements to the right (adds one to their
+ * indices).
+ *
+ * @param index index at which the specified element is to be inserted
+ * @param element element to be inserted
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+void list_addAt(list_List list, int64_t index, void* element) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	ARRAY(addAt)(sync->list, index, element);
+	endWrite(sync);
+}
+
+/**
+ * Removes the element at the specified position in this list (optional
+ * operation).  Shifts any subsequent elements to the left (subtracts one
+ * from their indices).  Returns the element that was removed from the
+ * list.
+ *
+ * @param index the index of the element to be removed
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_removeAt(list_List list, int64_t index) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	beginWrite(sync);
+	void* result = ARRAY(removeAt)(sync->list, index);
+	endWrite(sync);
+	return result;
+}
+
+
+
+// Search Operations
+
+/**
+ * Returns the index of the first occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the first occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_indexOf(list_List list, void* o) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	void** array;
+	int64_t size;
+	int64_t result;
+	collection_epochEnter(sync->domain);
+	for (;;) {
+		uint64_t sequence = beginRead(sync);
+		if (!readHeader(sync, sequence, &array, &size))
+			continue;
+		result = -1;
+		for (int64_t i = 0; i < size; ++i)
+			if (readSlot(array, i) == o) {
+				result = i;
+				break;
+			}
+		if (validate(sync, sequence))
+			break;
+	}
+	collection_epochExit(sync->domain);
+	return result;
+}
+
+/**
+ * Returns the index of the last occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the highest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the last occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_lastIndexOf(list_List list, void* o) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	void** array;
+	int64_t size;
+	int64_t result;
+	collection_epochEnter(sync->domain);
+	for (;;) {
+		uint64_t sequence = beginRead(sync);
+		if (!readHeader(sync, sequence, &array, &size))
+			continue;
+		result = -1;
+		for (int64_t i = size - 1; i >= 0; --i)
+			if (readSlot(array, i) == o) {
+				result = i;
+				break;
+			}
+		if (validate(sync, sequence))
+			break;
+	}
+	collection_epochExit(sync->domain);
+	return result;
+}
+
+
+
+// Iteration
+
+/**
+ * Calls <tt>action</tt> on each element of this list in order, until it
+ * returns <tt>false</tt>.  The elements visited are those the list held
+ * when the call started: the iteration runs over a snapshot that shares
+ * the backing array, so it holds the writer mutex only to take the
+ * snapshot, and the action may read and modify the list.  The first write
+ * made while the iteration runs copies the backing array.
+ *
+ * @param action the function called on each element
+ * @param context passed through to every call of <tt>action</tt>
+ * @return <tt>true</tt> if every element was visited
+ */
+bool list_forEach(list_List list, list_Consumer action, void* context) {
+	SynchronizedList* sync = (SynchronizedList*) list;
+	pthread_mutex_lock(&sync->lock);
+	list_List snapshot = ARRAY(snapshot)(sync->list);
+	pthread_mutex_unlock(&sync->lock);
+	bool result = ARRAY(forEach)(snapshot, action, context);
+	ARRAY(delList)(snapshot);
+	return result;
+}
+
+/**
+ * Not supported by the synchronized list.
+ */
+size_t list_nextSpan(list_List list, int64_t* position, void* const** data) {
+	unsupported("nextSpan");
+}
+
+
+
+// View
+
+/**
+ * Not supported by the synchronized list.
+ */
+list_List list_subList(list_List list, int64_t fromIndex, int64_t toIndex) {
+	unsupported("subList");
+}
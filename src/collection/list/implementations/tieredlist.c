@@ -0,0 +1,959 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "collection/allocator.h"
+
+#define LIST_IMPLEMENTATION tiered
+#include "collection/list/implementations/tieredlist.h"
+#include "multiset.h"
+
+/*
+ * Tiered vector.  The elements are stored in blocks of 2^shift slots, each
+ * block a circular buffer with its own head, indexed by a top-level array
+ * of blocks.  Every block but the last is full, so element i lives in
+ * block i >> shift and get is two loads and a mask.
+ *
+ * Inserting at i makes room in its block by moving at most half of that
+ * block, then pushes the overflow through the following blocks: each one
+ * rotates its head back by one slot and takes the last element of its
+ * predecessor, which is O(1) per block.  Removal is the mirror image.  With
+ * the block size kept near sqrt(n) both cost O(sqrt(n)); the blocks are
+ * rebuilt with a doubled or halved block size when the list outgrows that
+ * balance.
+ *
+ * A subList is a view holding an offset into the root list, which owns the
+ * blocks.  Structural changes made through a view are applied to the root
+ * and reflected in the sizes of the view and its enclosing views.
+ */
+
+#define MIN_SHIFT 4
+#define INIT_TOP_CAPACITY 8
+
+typedef struct Block {
+	int64_t head;
+	void* slots[];
+} Block;
+
+typedef struct TieredList {
+	Block** blocks; // root only
+	int64_t blockCount; // root only
+	int64_t topCapacity; // root only
+	int shift; // root only, log2 of the block size
+	int64_t size;
+	int64_t offset; // index of the first element of a view in the root
+	struct TieredList* superList;
+	struct TieredList* root;
+	const collection_Allocator* allocator;
+} TieredList;
+
+static void** slotAt(TieredList* root, int64_t index) {
+	Block* block = root->blocks[index >> root->shift];
+	return &block->slots[(block->head + index) & (((int64_t) 1 << root->shift) - 1)];
+}
+
+static void** blockSlot(Block* block, int64_t mask, int64_t position) {
+	return &block->slots[(block->head + position) & mask];
+}
+
+/*
+ * Returns in run the longest contiguous run of slots holding the elements
+ * starting at index, at most length of them.  Returns the run length.
+ */
+static int64_t runAt(TieredList* root, int64_t index, int64_t length, void*** run) {
+	int64_t blockSize = (int64_t) 1 << root->shift;
+	Block* block = root->blocks[index >> root->shift];
+	int64_t start = (block->head + index) & (blockSize - 1);
+	int64_t result = blockSize - start;
+	if (result > blockSize - (index & (blockSize - 1)))
+		result = blockSize - (index & (blockSize - 1));
+	if (result > length)
+		result = length;
+	*run = block->slots + start;
+	return result;
+}
+
+static void copyOut(TieredList* root, int64_t from, int64_t length, void** dest) {
+	while (length > 0) {
+		void** run;
+		int64_t runLength = runAt(root, from, length, &run);
+		memcpy(dest, run, sizeof(void*) * runLength);
+		dest += runLength;
+		from += runLength;
+		length -= runLength;
+	}
+}
+
+static Block* newBlock(TieredList* root, int shift) {
+	const collection_Allocator* allocator = root->allocator;
+	Block* result = allocator->allocate(allocator->context,
+			sizeof(Block) + (sizeof(void*) << shift));
+	assert(result != NULL);
+	result->head = 0;
+	return result;
+}
+
+static void delBlock(TieredList* root, Block* block) {
+	const collection_Allocator* allocator = root->allocator;
+	allocator->deallocate(allocator->context, block,
+			sizeof(Block) + (sizeof(void*) << root->shift));
+}
+
+static void appendBlock(TieredList* root) {
+	if (root->blockCount == root->topCapacity) {
+		const collection_Allocator* allocator = root->allocator;
+		root->blocks = allocator->reallocate(allocator->context, root->blocks,
+				sizeof(Block*) * root->topCapacity, sizeof(Block*) * root->topCapacity * 2);
+		assert(root->blocks != NULL);
+		root->topCapacity *= 2;
+	}
+	root->blocks[root->blockCount++] = newBlock(root, root->shift);
+}
+
+static void pushBack(TieredList* root, void* e) {
+	if (root->size == root->blockCount << root->shift)
+		appendBlock(root);
+	*slotAt(root, root->size++) = e;
+}
+
+static void shrinkTo(TieredList* root, int64_t newSize) {
+	int64_t keep = (newSize + ((int64_t) 1 << root->shift) - 1) >> root->shift;
+	while (root->blockCount > keep)
+		delBlock(root, root->blocks[--root->blockCount]);
+	root->size = newSize;
+}
+
+/*
+ * Rebuilds the blocks with blocks of 2^shift slots.
+ */
+static void reshape(TieredList* root, int shift) {
+	const collection_Allocator* allocator = root->allocator;
+	int64_t blockSize = (int64_t) 1 << shift;
+	int64_t blockCount = (root->size + blockSize - 1) >> shift;
+	int64_t topCapacity = blockCount > INIT_TOP_CAPACITY ? blockCount : INIT_TOP_CAPACITY;
+	Block** blocks = allocator->allocate(allocator->context, sizeof(Block*) * topCapacity);
+	assert(blocks != NULL);
+	for (int64_t j = 0; j < blockCount; ++j) {
+		int64_t from = j << shift;
+		int64_t length = root->size - from < blockSize ? root->size - from : blockSize;
+		blocks[j] = newBlock(root, shift);
+		copyOut(root, from, length, blocks[j]->slots);
+	}
+	for (int64_t j = 0; j < root->blockCount; ++j)
+		delBlock(root, root->blocks[j]);
+	allocator->deallocate(allocator->context, root->blocks, sizeof(Block*) * root->topCapacity);
+	root->blocks = blocks;
+	root->blockCount = blockCount;
+	root->topCapacity = topCapacity;
+	root->shift = shift;
+}
+
+/*
+ * Keeps the block size between sqrt(size / 2) and sqrt(4 * size), so that
+ * there are never more than twice as many blocks as slots in a block.
+ */
+static void rebalance(TieredList* root) {
+	int shift = root->shift;
+	while (root->size > (int64_t) 2 << (2 * shift))
+		++shift;
+	while (shift > MIN_SHIFT && root->size < (int64_t) 1 << (2 * shift - 2))
+		--shift;
+	if (shift != root->shift)
+		reshape(root, shift);
+}
+
+static void insertOne(TieredList* root, int64_t index, void* e) {
+	int64_t mask = ((int64_t) 1 << root->shift) - 1;
+	if (root->size == root->blockCount << root->shift)
+		appendBlock(root);
+	int64_t k = index >> root->shift;
+	// make room at the front of each block after k with the overflow of its predecessor
+	for (int64_t j = root->blockCount - 1; j > k; --j) {
+		Block* previous = root->blocks[j - 1];
+		Block* block = root->blocks[j];
+		block->head = (block->head - 1) & mask;
+		block->slots[block->head] = *blockSlot(previous, mask, mask);
+	}
+	Block* block = root->blocks[k];
+	int64_t length = k == root->blockCount - 1 ? root->size - (k << root->shift) : mask;
+	int64_t p = index & mask;
+	if (p < length - p) {
+		block->head = (block->head - 1) & mask;
+		for (int64_t i = 0; i < p; ++i)
+			*blockSlot(block, mask, i) = *blockSlot(block, mask, i + 1);
+	} else
+		for (int64_t i = length; i > p; --i)
+			*blockSlot(block, mask, i) = *blockSlot(block, mask, i - 1);
+	*blockSlot(block, mask, p) = e;
+	++root->size;
+}
+
+static void* removeOne(TieredList* root, int64_t index) {
+	int64_t mask = ((int64_t) 1 << root->shift) - 1;
+	int64_t k = index >> root->shift;
+	Block* block = root->blocks[k];
+	int64_t length = k == root->blockCount - 1 ? root->size - (k << root->shift) : mask + 1;
+	int64_t p = index & mask;
+	void* result = *blockSlot(block, mask, p);
+	if (p < length - 1 - p) {
+		for (int64_t i = p; i > 0; --i)
+			*blockSlot(block, mask, i) = *blockSlot(block, mask, i - 1);
+		block->head = (block->head + 1) & mask;
+	} else
+		for (int64_t i = p; i < length - 1; ++i)
+			*blockSlot(block, mask, i) = *blockSlot(block, mask, i + 1);
+	// fill the last slot of each block from k on with the front of its successor
+	for (int64_t j = k + 1; j < root->blockCount; ++j) {
+		Block* next = root->blocks[j];
+		*blockSlot(root->blocks[j - 1], mask, mask) = next->slots[next->head];
+		next->head = (next->head + 1) & mask;
+	}
+	shrinkTo(root, root->size - 1);
+	return result;
+}
+
+/*
+ * Inserts arrLength elements at index of the root.  A few elements are
+ * inserted one at a time; past the point where that would move more than
+ * the tail of the list, the tail is copied out and appended back instead.
+ */
+static void insertElements(TieredList* root, int64_t index, void* arr[], int64_t arrLength) {
+	int64_t tail = root->size - index;
+	int64_t perElement = root->blockCount + ((int64_t) 1 << root->shift);
+	if (arrLength * perElement < tail + arrLength) {
+		for (int64_t i = 0; i < arrLength; ++i)
+			insertOne(root, index + i, arr[i]);
+	} else {
+		const collection_Allocator* allocator = root->allocator;
+		void** saved = allocator->allocate(allocator->context, sizeof(void*) * (tail > 0 ? tail : 1));
+		assert(saved != NULL);
+		copyOut(root, index, tail, saved);
+		shrinkTo(root, index);
+		for (int64_t i = 0; i < arrLength; ++i)
+			pushBack(root, arr[i]);
+		for (int64_t i = 0; i < tail; ++i)
+			pushBack(root, saved[i]);
+		allocator->deallocate(allocator->context, saved, sizeof(void*) * (tail > 0 ? tail : 1));
+	}
+	rebalance(root);
+}
+
+/*
+ * Removes the elements [from, to) of the root, with the same choice
+ * between single removals and moving the tail as insertElements.
+ */
+static void removeElements(TieredList* root, int64_t from, int64_t to) {
+	int64_t n = to - from;
+	int64_t tail = root->size - to;
+	int64_t perElement = root->blockCount + ((int64_t) 1 << root->shift);
+	if (n == 0)
+		return;
+	if (n * perElement < tail + n) {
+		for (int64_t i = 0; i < n; ++i)
+			removeOne(root, from);
+	} else if (tail == 0)
+		shrinkTo(root, from);
+	else {
+		const collection_Allocator* allocator = root->allocator;
+		void** saved = allocator->allocate(allocator->context, sizeof(void*) * tail);
+		assert(saved != NULL);
+		copyOut(root, to, tail, saved);
+		shrinkTo(root, from);
+		for (int64_t i = 0; i < tail; ++i)
+			pushBack(root, saved[i]);
+		allocator->deallocate(allocator->context, saved, sizeof(void*) * tail);
+	}
+	rebalance(root);
+}
+
+static void adjustViewSizes(TieredList* list, int64_t delta) {
+	for (TieredList* view = list; view != view->root; view = view->superList)
+		view->size += delta;
+}
+
+list_List list_newList() {
+	return list_newListWithAllocator(&collection_stdAllocator);
+}
+
+/**
+ * Constructs an empty list whose header, backing array and any scratch
+ * memory used by its operations are obtained from <tt>allocator</tt>.
+ * Arrays returned by {@link #toArray} are still allocated with
+ * <tt>malloc</tt> since their ownership passes to the caller.
+ *
+ * @param allocator allocator that must outlive the list
+ * @return the new list
+ */
+list_List list_newListWithAllocator(const collection_Allocator* allocator) {
+	TieredList* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(TieredList));
+	assert(result != NULL);
+	memset(result, 0, sizeof(TieredList));
+	result->blocks = allocator->allocate(allocator->context, sizeof(Block*) * INIT_TOP_CAPACITY);
+	assert(result->blocks != NULL);
+	result->topCapacity = INIT_TOP_CAPACITY;
+	result->shift = MIN_SHIFT;
+	result->root = result;
+	result->allocator = allocator;
+	return (list_List) result;
+}
+
+bool list_delList(list_List list) {
+	TieredList* tiered = (TieredList*) list;
+	const collection_Allocator* allocator = tiered->allocator;
+	if (tiered->superList == NULL) {
+		for (int64_t j = 0; j < tiered->blockCount; ++j)
+			delBlock(tiered, tiered->blocks[j]);
+		allocator->deallocate(allocator->context, tiered->blocks,
+				sizeof(Block*) * tiered->topCapacity);
+	}
+	allocator->deallocate(allocator->context, tiered, sizeof(TieredList));
+	return true;
+}
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of elements in this list.  If this list contains
+ * more than <tt>Integer.MAX_VALUE</tt> elements, returns
+ * <tt>Integer.MAX_VALUE</tt>.
+ *
+ * @return the number of elements in this list
+ */
+int64_t list_size(list_List list) {
+	TieredList* tiered = (TieredList*) list;
+	return tiered->size;
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains no elements.
+ *
+ * @return <tt>true</tt> if this list contains no elements
+ */
+bool list_isEmpty(list_List list) {
+	TieredList* tiered = (TieredList*) list;
+	return tiered->size == 0;
+}
+
+/**
+ * Returns <tt>true</tt> if this list contains the specified element.
+ * More formally, returns <tt>true</tt> if and only if this list contains
+ * at least one element <tt>e</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;e==null&nbsp;:&nbsp;o.equals(e))</tt>.
+ *
+ * @param o element whose presence in this list is to be tested
+ * @return <tt>true</tt> if this list contains the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+bool list_contains(list_List list, void* o) {
+	return list_indexOf(list, o) >= 0;
+}
+
+/**
+ * Returns an array containing all of the elements in this list in proper
+ * sequence (from first to last element).
+ *
+ * <p>The returned array will be "safe" in that no references to it are
+ * maint64_tained by this list.  (In other words, this method must
+ * allocate a new array even if this list is backed by an array).
+ * The caller is thus free to modify the returned array.
+ *
+ * <p>This method acts as bridge between array-based and collection-based
+ * APIs.
+ *
+ * @return an array containing all of the elements in this list in proper
+ * sequence
+ */
+void** list_toArray(list_List list) {
+	TieredList* tiered = (TieredList*) list;
+	void** result = NULL;
+	result = malloc(sizeof(void*) * (tiered->size > 0 ? tiered->size : 1));
+	assert(result != NULL);
+	copyOut(tiered->root, tiered->offset, tiered->size, result);
+	return result;
+}
+
+
+
+// Modification Operations
+
+/**
+ * Appends the specified element to the end of this list (optional
+ * operation).
+ *
+ * <p>Lists that support this operation may place limitations on what
+ * elements may be added to this list.  In particular, some
+ * lists will refuse to add null elements, and others will impose
+ * restrictions on the type of elements that may be added.  List
+ * classes should clearly specify in their documentation any restrictions
+ * on what elements may be added.
+ *
+ * @param e element to be appended to this list
+ * @return <tt>true</tt> (as specified by {@link Collection#add})
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements
+ * @throws IllegalArgumentException if some property of this element
+ * prevents it from being added to this list
+ */
+bool list_add(list_List list, void* e) {
+	TieredList* tiered = (TieredList*) list;
+	list_addAt(list, tiered->size, e);
+	return true;
+}
+
+/**
+ * Removes the first occurrence of the specified element from this list,
+ * if it is present (optional operation).  If this list does not contain
+ * the element, it is unchanged.  More formally, removes the element with
+ * the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>
+ * (if such an element exists).  Returns <tt>true</tt> if this list
+ * contained the specified element (or equivalently, if this list changed
+ * as a result of the call).
+ *
+ * @param o element to be removed from this list, if present
+ * @return <tt>true</tt> if this list contained the specified element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ */
+bool list_remove(list_List list, void* o) {
+	int64_t index = list_indexOf(list, o);
+	if (index < 0)
+		return false;
+	list_removeAt(list, index);
+	return true;
+}
+
+
+
+// Bulk Modification Operations
+
+/**
+ * Returns <tt>true</tt> if this list contains all of the elements of the
+ * specified collection.
+ *
+ * @param  c collection to be checked for containment in this list
+ * @return <tt>true</tt> if this list contains all of the elements of the
+ * specified collection
+ * @throws ClassCastException if the types of one or more elements
+ * in the specified collection are incompatible with this
+ * list (optional)
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements (optional), or if the specified collection is null
+ * @see #contains(void*)
+ */
+bool list_containsAll(list_List list, void* arr[], size_t arrLength) {
+	TieredList* tiered = (TieredList*) list;
+	if (arrLength > (size_t) tiered->size)
+		return false;
+	Multiset set;
+	multisetInit(&set, tiered->allocator, arr, arrLength);
+	// each list element may satisfy at most one occurrence in arr
+	size_t remaining = arrLength;
+	for (int64_t i = 0; i < tiered->size && remaining > 0; ++i)
+		if (multisetTake(&set, *slotAt(tiered->root, tiered->offset + i)))
+			--remaining;
+	multisetFree(&set);
+	return remaining == 0;
+}
+
+/*
+ * Stable compaction shared by removeAll and retainAll, with the matching
+ * rules of the ArrayList: every occurrence in arr matches the first equal
+ * element not matched yet.
+ */
+static bool filterList(TieredList* tiered, void* arr[], size_t arrLength, bool retain) {
+	TieredList* root = tiered->root;
+	Multiset set;
+	multisetInit(&set, tiered->allocator, arr, arrLength);
+	int64_t newSize = 0;
+	for (int64_t i = 0; i < tiered->size; ++i) {
+		void* e = *slotAt(root, tiered->offset + i);
+		if (multisetTake(&set, e) == retain)
+			*slotAt(root, tiered->offset + newSize++) = e;
+	}
+	multisetFree(&set);
+	if (newSize == tiered->size)
+		return false;
+	int64_t removed = tiered->size - newSize;
+	removeElements(root, tiered->offset + newSize, tiered->offset + tiered->size);
+	adjustViewSizes(tiered, -removed);
+	return true;
+}
+
+/**
+ * Appends all of the elements in the specified collection to the end of
+ * this list, in the order that they are returned by the specified
+ * collection's iterator (optional operation).  The behavior of this
+ * operation is undefined if the specified collection is modified while
+ * the operation is in progress.  (Note that this will occur if the
+ * specified collection is this list, and it's nonempty.)
+ *
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @see #add(void*)
+ */
+bool list_addAll(list_List list, void* arr[], size_t arrLength) {
+	TieredList* tiered = (TieredList*) list;
+	return list_addAllAt(list, tiered->size, arr, arrLength);
+}
+
+/**
+ * Inserts all of the elements in the specified collection int64_to this
+ * list at the specified position (optional operation).  Shifts the
+ * element currently at that position (if any) and any subsequent
+ * elements to the right (increases their indices).  The new elements
+ * will appear in this list in the order that they are returned by the
+ * specified collection's iterator.  The behavior of this operation is
+ * undefined if the specified collection is modified while the
+ * operation is in progress.  (Note that this will occur if the specified
+ * collection is this list, and it's nonempty.)
+ *
+ * @param index index at which to insert the first element from the
+ *  specified collection
+ * @param c collection containing elements to be added to this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>addAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of the specified
+ * collection prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified collection contains one
+ * or more null elements and this list does not permit null
+ * elements, or if the specified collection is null
+ * @throws IllegalArgumentException if some property of an element of the
+ * specified collection prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+bool list_addAllAt(list_List list, int64_t index, void* arr[], size_t arrLength) {
+	TieredList* tiered = (TieredList*) list;
+	assert(index >= 0 && index <= tiered->size);
+	insertElements(tiered->root, tiered->offset + index, arr, arrLength);
+	adjustViewSizes(tiered, arrLength);
+	return true;
+}
+
+/**
+ * Removes from this list all of its elements that are contained in the
+ * specified collection (optional operation).
+ *
+ * @param c collection containing elements to be removed from this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>removeAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_removeAll(list_List list, void* arr[], size_t arrLength) {
+	TieredList* tiered = (TieredList*) list;
+	return filterList(tiered, arr, arrLength, false);
+}
+
+/**
+ * Retains only the elements in this list that are contained in the
+ * specified collection (optional operation).  In other words, removes
+ * from this list all of its elements that are not contained in the
+ * specified collection.
+ *
+ * @param c collection containing elements to be retained in this list
+ * @return <tt>true</tt> if this list changed as a result of the call
+ * @throws UnsupportedOperationException if the <tt>retainAll</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of an element of this list
+ * is incompatible with the specified collection (optional)
+ * @throws NullPoint64_terException if this list contains a null element and the
+ * specified collection does not permit null elements (optional),
+ * or if the specified collection is null
+ * @see #remove(void*)
+ * @see #contains(void*)
+ */
+bool list_retainAll(list_List list, void* arr[], size_t arrLength) {
+	TieredList* tiered = (TieredList*) list;
+	return filterList(tiered, arr, arrLength, true);
+}
+
+/**
+ * Removes all of the elements from this list (optional operation).
+ * The list will be empty after this call returns.
+ *
+ * @throws UnsupportedOperationException if the <tt>clear</tt> operation
+ * is not supported by this list
+ */
+void list_clear(list_List list) {
+	TieredList* tiered = (TieredList*) list;
+	list_removeRange(list, 0, tiered->size);
+}
+
+
+
+// Comparison and hashing
+
+/**
+ * Compares the specified object with this list for equality.  Returns
+ * <tt>true</tt> if and only if the specified object is also a list, both
+ * lists have the same size, and all corresponding pairs of elements in
+ * the two lists are <i>equal</i>.  (Two elements <tt>e1</tt> and
+ * <tt>e2</tt> are <i>equal</i> if <tt>(e1==null ? e2==null :
+ * e1.equals(e2))</tt>.)  In other words, two lists are defined to be
+ * equal if they contain the same elements in the same order.  This
+ * definition ensures that the equals method works properly across
+ * different implementations of the <tt>List</tt> int64_terface.
+ *
+ * @param o the object to be compared for equality with this list
+ * @return <tt>true</tt> if the specified object is equal to this list
+ */
+bool list_equals(list_List list, list_List o) {
+	TieredList* tiered = (TieredList*) list;
+	TieredList* tiered2 = (TieredList*) o;
+	if (tiered->size != tiered2->size)
+		return false;
+	for (int64_t i = 0; i < tiered->size; ++i)
+		if (*slotAt(tiered->root, tiered->offset + i) != *slotAt(tiered2->root, tiered2->offset + i))
+			return false;
+	return true;
+}
+
+
+
+// Positional Access Operations
+
+/**
+ * Returns the element at the specified position in this list.
+ *
+ * @param index index of the element to return
+ * @return the element at the specified position in this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_get(list_List list, int64_t index) {
+	TieredList* tiered = (TieredList*) list;
+	assert(index >= 0 && index < tiered->size);
+	return *slotAt(tiered->root, tiered->offset + index);
+}
+
+/**
+ * Replaces the element at the specified position in this list with the
+ * specified element (optional operation).
+ *
+ * @param index index of the element to replace
+ * @param element element to be stored at the specified position
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>set</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_set(list_List list, int64_t index, void* element) {
+	TieredList* tiered = (TieredList*) list;
+	assert(index >= 0 && index < tiered->size);
+	void** slot = slotAt(tiered->root, tiered->offset + index);
+	void* result = *slot;
+	*slot = element;
+	return result;
+}
+
+/**
+ * Inserts the specified element at the specified position in this list
+ * (optional operation).  Shifts the element currently at that position
+ * (if any) and any subsequent elements to the right (adds one to their
+ * indices).
+ *
+ * @param index index at which the specified element is to be inserted
+ * @param element element to be inserted
+ * @throws UnsupportedOperationException if the <tt>add</tt> operation
+ * is not supported by this list
+ * @throws ClassCastException if the class of the specified element
+ * prevents it from being added to this list
+ * @throws NullPoint64_terException if the specified element is null and
+ * this list does not permit null elements
+ * @throws IllegalArgumentException if some property of the specified
+ * element prevents it from being added to this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt; size()</tt>)
+ */
+void list_addAt(list_List list, int64_t index, void* element) {
+	TieredList* tiered = (TieredList*) list;
+	assert(index >= 0 && index <= tiered->size);
+	insertOne(tiered->root, tiered->offset + index, element);
+	rebalance(tiered->root);
+	adjustViewSizes(tiered, 1);
+}
+
+/**
+ * Removes the element at the specified position in this list (optional
+ * operation).  Shifts any subsequent elements to the left (subtracts one
+ * from their indices).  Returns the element that was removed from the
+ * list.
+ *
+ * @param index the index of the element to be removed
+ * @return the element previously at the specified position
+ * @throws UnsupportedOperationException if the <tt>remove</tt> operation
+ * is not supported by this list
+ * @throws IndexOutOfBoundsException if the index is out of range
+ * (<tt>index &lt; 0 || index &gt;= size()</tt>)
+ */
+void* list_removeAt(list_List list, int64_t index) {
+	TieredList* tiered = (TieredList*) list;
+	assert(index >= 0 && index < tiered->size);
+	void* result = removeOne(tiered->root, tiered->offset + index);
+	rebalance(tiered->root);
+	adjustViewSizes(tiered, -1);
+	return result;
+}
+
+/**
+ * Removes from this list all of the elements whose index is between
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  Shifts
+ * any succeeding elements to the left (reduces their index).  If
+ * <tt>toIndex==fromIndex</tt>, this operation has no effect.
+ *
+ * @param fromIndex index of first element to be removed
+ * @param toIndex index after last element to be removed
+ * @throws IndexOutOfBoundsException if <tt>fromIndex</tt> or
+ * <tt>toIndex</tt> is out of range
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size() || toIndex &lt; fromIndex</tt>)
+ */
+void list_removeRange(list_List list, int64_t fromIndex, int64_t toIndex) {
+	TieredList* tiered = (TieredList*) list;
+	assert(fromIndex >= 0 && toIndex <= tiered->size && toIndex >= fromIndex);
+	removeElements(tiered->root, tiered->offset + fromIndex, tiered->offset + toIndex);
+	adjustViewSizes(tiered, fromIndex - toIndex);
+}
+
+
+
+// Capacity Operations
+
+/**
+ * Returns the number of elements held by each block of this list.  The
+ * block size is a power of two kept close to the square root of the size
+ * of the list; it is doubled or halved, rebuilding the blocks, as the
+ * list grows or shrinks.
+ *
+ * @return the block size of this list
+ */
+int64_t list_blockSize(list_List list) {
+	TieredList* tiered = (TieredList*) list;
+	return (int64_t) 1 << tiered->root->shift;
+}
+
+
+
+// Search Operations
+
+/**
+ * Returns the index of the first occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the lowest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the first occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_indexOf(list_List list, void* o) {
+	TieredList* tiered = (TieredList*) list;
+	for (int64_t i = 0; i < tiered->size;) {
+		void** run;
+		int64_t runLength = runAt(tiered->root, tiered->offset + i, tiered->size - i, &run);
+		for (int64_t j = 0; j < runLength; ++j)
+			if (run[j] == o)
+				return i + j;
+		i += runLength;
+	}
+	return -1;
+}
+
+/**
+ * Returns the index of the last occurrence of the specified element
+ * in this list, or -1 if this list does not contain the element.
+ * More formally, returns the highest index <tt>i</tt> such that
+ * <tt>(o==null&nbsp;?&nbsp;get(i)==null&nbsp;:&nbsp;o.equals(get(i)))</tt>,
+ * or -1 if there is no such index.
+ *
+ * @param o element to search for
+ * @return the index of the last occurrence of the specified element in
+ * this list, or -1 if this list does not contain the element
+ * @throws ClassCastException if the type of the specified element
+ * is incompatible with this list (optional)
+ * @throws NullPoint64_terException if the specified element is null and this
+ * list does not permit null elements (optional)
+ */
+int64_t list_lastIndexOf(list_List list, void* o) {
+	TieredList* tiered = (TieredList*) list;
+	for (int64_t i = tiered->size - 1; i >= 0; --i)
+		if (*slotAt(tiered->root, tiered->offset + i) == o)
+			return i;
+	return -1;
+}
+
+
+
+// Iteration
+
+/**
+ * Calls <tt>action</tt> on each element of this list in order, until it
+ * returns <tt>false</tt>.  Nothing is allocated or copied.  The behavior
+ * is undefined if the list is structurally modified by the action.
+ *
+ * @param action the function called on each element
+ * @param context passed through to every call of <tt>action</tt>
+ * @return <tt>true</tt> if every element was visited
+ */
+bool list_forEach(list_List list, list_Consumer action, void* context) {
+	int64_t position = 0;
+	void* const* data;
+	size_t length;
+	while ((length = list_nextSpan(list, &position, &data)) > 0)
+		for (size_t i = 0; i < length; ++i)
+			if (!action(data[i], context))
+				return false;
+	return true;
+}
+
+/**
+ * Advances a cursor over the elements of this list one contiguous span of
+ * the backing storage at a time.  Start with <tt>*position</tt> set to 0
+ * and call repeatedly; each call points <tt>*data</tt> at the next run of
+ * consecutive elements, in list order, and advances <tt>*position</tt>
+ * past it.  For a view the spans cover only the view.  The slots must not
+ * be written through <tt>*data</tt>, and the behavior is undefined if the
+ * list is structurally modified during the iteration.  Nothing is
+ * allocated or copied.
+ *
+ * @param position index of the next element to return, 0 to start
+ * @param data receives the address of the first element of the span
+ * @return the number of elements in the span, 0 once the end of the list
+ * is reached
+ */
+size_t list_nextSpan(list_List list, int64_t* position, void* const** data) {
+	TieredList* tiered = (TieredList*) list;
+	assert(*position >= 0 && *position <= tiered->size);
+	if (*position == tiered->size)
+		return 0;
+	void** run;
+	int64_t length = runAt(tiered->root, tiered->offset + *position, tiered->size - *position, &run);
+	*data = run;
+	*position += length;
+	return length;
+}
+
+
+
+// View
+
+/**
+ * Returns a view of the portion of this list between the specified
+ * <tt>fromIndex</tt>, inclusive, and <tt>toIndex</tt>, exclusive.  (If
+ * <tt>fromIndex</tt> and <tt>toIndex</tt> are equal, the returned list is
+ * empty.)  The returned list is backed by this list, so non-structural
+ * changes in the returned list are reflected in this list, and vice-versa.
+ * The returned list supports all of the optional list operations supported
+ * by this list.<p>
+ *
+ * This method eliminates the need for explicit range operations (of
+ * the sort that commonly exist for arrays).  Any operation that expects
+ * a list can be used as a range operation by passing a subList view
+ * instead of a whole list.  For example, the following idiom
+ * removes a range of elements from a list:
+ * <pre>
+ *  list.subList(from, to).clear();
+ * </pre>
+ * Similar idioms may be constructed for <tt>indexOf</tt> and
+ * <tt>lastIndexOf</tt>, and all of the algorithms in the
+ * <tt>Collections</tt> class can be applied to a subList.<p>
+ *
+ * The semantics of the list returned by this method become undefined if
+ * the backing list (i.e., this list) is <i>structurally modified</i> in
+ * any way other than via the returned list.  (Structural modifications are
+ * those that change the size of this list, or otherwise perturb it in such
+ * a fashion that iterations in progress may yield incorrect results.)
+ *
+ * @param fromIndex low endpoint64_t (inclusive) of the subList
+ * @param toIndex high endpoint64_t (exclusive) of the subList
+ * @return a view of the specified range within this list
+ * @throws IndexOutOfBoundsException for an illegal endpoint64_t index value
+ * (<tt>fromIndex &lt; 0 || toIndex &gt; size ||
+ * fromIndex &gt; toIndex</tt>)
+ */
+list_List list_subList(list_List list, int64_t fromIndex, int64_t toIndex) {
+	TieredList* tiered = (TieredList*) list;
+	assert(fromIndex >= 0 && toIndex <= tiered->size && toIndex >= fromIndex);
+	const collection_Allocator* allocator = tiered->allocator;
+	TieredList* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(TieredList));
+	assert(result != NULL);
+	memset(result, 0, sizeof(TieredList));
+	result->size = toIndex - fromIndex;
+	result->offset = tiered->offset + fromIndex;
+	result->superList = tiered;
+	result->root = tiered->root;
+	result->allocator = allocator;
+	return (list_List) result;
+}
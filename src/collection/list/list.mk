@@ -3,15 +3,21 @@ abort:   ## This MUST be the first target :( ugly
 	@echo Make must be run from the root of the project && false
 endif
 
-CURRENT_DIR+=/list
+CURRENT_DIR:=$(CURRENT_DIR)/list
 
-all: implementations liblist.so
+export LIST_IMPLEMENTATIONS_OBJ:= implementations/arraylist.o implementations/typedlist.o implementations/arraydeque.o implementations/tieredlist.o implementations/concurrentlist.o implementations/syncarraylist.o implementations/synchronizedlist.o
 
-implementations: implementations/* export CURRENT_DIR+=/implementations
-	$(MAKE) -C $(BASE_DIR)/$(CURRENT_DIR) -f implementations.mk
+all: implementations liblist.so liblist.a
 
-liblist.so: implementations list.o
-        gcc -shared -o liblist.so list.o $(IMPLEMENTATIONS_OBJ)
+.PHONY: implementations
+# objects are left out so that make does not try to rebuild them from here
+implementations: $(filter-out %.o,$(wildcard implementations/*))
+	$(MAKE) -C $(BASE_DIR)/$(CURRENT_DIR)/implementations -f implementations.mk
 
-list.o: list.h list.c
-        gcc -c -Wall -fpic list.c
+liblist.so: implementations
+	gcc -shared $(COLLECTION_LDFLAGS) -o liblist.so $(LIST_IMPLEMENTATIONS_OBJ) $(COLLECTION_OBJ) -lpthread
+
+# gcc-ar also indexes the bytecode of objects built with LTO=1
+liblist.a: implementations
+	rm -f liblist.a
+	gcc-ar rcs liblist.a $(LIST_IMPLEMENTATIONS_OBJ) $(COLLECTION_OBJ)
@@ -0,0 +1,416 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "collection/allocator.h"
+#include "collection/epoch.h"
+
+#define MAP_IMPLEMENTATION concurrent
+#include "collection/map/implementations/concurrenthashmap.h"
+
+/*
+ * Separate chaining over a power of two table of atomic bucket heads.
+ * Readers walk the chains without locking inside an epoch critical
+ * section.  Writers lock the stripe given by the low bits of the hash;
+ * since the table has at least as many buckets as there are stripes, every
+ * bucket belongs to exactly one stripe.  An insertion links a new node at
+ * the head of its bucket and a removal unlinks the node and retires it,
+ * leaving its next pointer intact for readers still standing on it.
+ *
+ * Growing takes every stripe and copies the nodes into a table twice the
+ * size, then publishes it and retires the old table and nodes.  Nodes are
+ * copied rather than relinked so that a reader still walking an old chain
+ * never follows a pointer into a different bucket.
+ */
+
+#define STRIPE_COUNT 64
+#define INIT_CAPACITY 64
+// the table grows once it would be more than 3/4 full
+#define MAX_LOAD_NUMERATOR 3
+#define MAX_LOAD_DENOMINATOR 4
+
+typedef struct Node {
+	uint64_t hash;
+	void* key;
+	_Atomic(void*) value;
+	_Atomic(struct Node*) next;
+} Node;
+
+typedef struct {
+	int64_t capacity; // always a power of two, at least STRIPE_COUNT
+	_Atomic(Node*) buckets[];
+} Table;
+
+typedef struct {
+	pthread_mutex_t lock;
+	_Atomic int64_t size; // mappings in the buckets of this stripe
+	// keep stripes on separate cache lines
+	char padding[64 - (sizeof(pthread_mutex_t) + sizeof(int64_t)) % 64];
+} Stripe;
+
+typedef struct {
+	_Atomic(Table*) table;
+	Stripe stripes[STRIPE_COUNT];
+	map_HashFunction hashFunction;
+	map_EqualsFunction equalsFunction;
+	collection_EpochDomain* domain;
+	const collection_Allocator* allocator;
+} ConcurrentHashMap;
+
+static uint64_t hashPointer(const void* p) {
+	uint64_t h = (uint64_t) (uintptr_t) p;
+	h ^= h >> 33;
+	h *= UINT64_C(0xff51afd7ed558ccd);
+	h ^= h >> 33;
+	return h;
+}
+
+static uint64_t hashKey(ConcurrentHashMap* map, const void* key) {
+	return map->hashFunction == NULL ? hashPointer(key) : map->hashFunction(key);
+}
+
+static bool keysEqual(ConcurrentHashMap* map, const void* a, const void* b) {
+	return a == b || (map->equalsFunction != NULL && map->equalsFunction(a, b));
+}
+
+static size_t tableBytes(int64_t capacity) {
+	return sizeof(Table) + sizeof(_Atomic(Node*)) * capacity;
+}
+
+static Table* newTable(ConcurrentHashMap* map, int64_t capacity) {
+	const collection_Allocator* allocator = map->allocator;
+	Table* table = allocator->allocate(allocator->context, tableBytes(capacity));
+	assert(table != NULL);
+	table->capacity = capacity;
+	for (int64_t i = 0; i < capacity; ++i)
+		atomic_init(&table->buckets[i], NULL);
+	return table;
+}
+
+static Node* newNode(ConcurrentHashMap* map, uint64_t hash, void* key, void* value, Node* next) {
+	const collection_Allocator* allocator = map->allocator;
+	Node* node = allocator->allocate(allocator->context, sizeof(Node));
+	assert(node != NULL);
+	node->hash = hash;
+	node->key = key;
+	atomic_init(&node->value, value);
+	atomic_init(&node->next, next);
+	return node;
+}
+
+static Node* findNode(ConcurrentHashMap* map, Table* table, const void* key, uint64_t hash) {
+	Node* node = atomic_load_explicit(&table->buckets[hash & (table->capacity - 1)],
+			memory_order_acquire);
+	while (node != NULL && !(node->hash == hash && keysEqual(map, node->key, key)))
+		node = atomic_load_explicit(&node->next, memory_order_acquire);
+	return node;
+}
+
+static void lockAll(ConcurrentHashMap* map) {
+	for (int i = 0; i < STRIPE_COUNT; ++i)
+		pthread_mutex_lock(&map->stripes[i].lock);
+}
+
+static void unlockAll(ConcurrentHashMap* map) {
+	for (int i = STRIPE_COUNT - 1; i >= 0; --i)
+		pthread_mutex_unlock(&map->stripes[i].lock);
+}
+
+/*
+ * Doubles the table unless another writer already replaced expected.
+ */
+static void grow(ConcurrentHashMap* map, Table* expected) {
+	lockAll(map);
+	Table* table = atomic_load_explicit(&map->table, memory_order_relaxed);
+	if (table != expected) {
+		unlockAll(map);
+		return;
+	}
+	Table* bigger = newTable(map, table->capacity * 2);
+	int64_t mask = bigger->capacity - 1;
+	for (int64_t i = 0; i < table->capacity; ++i)
+		for (Node* node = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+				node != NULL; node = atomic_load_explicit(&node->next, memory_order_relaxed)) {
+			_Atomic(Node*)* bucket = &bigger->buckets[node->hash & mask];
+			Node* copy = newNode(map, node->hash, node->key,
+					atomic_load_explicit(&node->value, memory_order_relaxed),
+					atomic_load_explicit(bucket, memory_order_relaxed));
+			atomic_store_explicit(bucket, copy, memory_order_relaxed);
+		}
+	atomic_store_explicit(&map->table, bigger, memory_order_release);
+	unlockAll(map);
+	for (int64_t i = 0; i < table->capacity; ++i) {
+		Node* node = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+		while (node != NULL) {
+			Node* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+			collection_epochRetire(map->domain, node, sizeof(Node));
+			node = next;
+		}
+	}
+	collection_epochRetire(map->domain, table, tableBytes(table->capacity));
+}
+
+/*
+ * Deallocates a table and its nodes directly.  Only for tables no reader
+ * can reach.
+ */
+static void freeTable(ConcurrentHashMap* map, Table* table) {
+	const collection_Allocator* allocator = map->allocator;
+	for (int64_t i = 0; i < table->capacity; ++i) {
+		Node* node = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+		while (node != NULL) {
+			Node* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+			allocator->deallocate(allocator->context, node, sizeof(Node));
+			node = next;
+		}
+	}
+	allocator->deallocate(allocator->context, table, tableBytes(table->capacity));
+}
+
+map_Map map_newMap() {
+	return map_newMapWithAllocator(NULL, NULL, &collection_stdAllocator);
+}
+
+map_Map map_newMapWithFunctions(map_HashFunction hash, map_EqualsFunction equals) {
+	return map_newMapWithAllocator(hash, equals, &collection_stdAllocator);
+}
+
+map_Map map_newMapWithAllocator(map_HashFunction hash, map_EqualsFunction equals,
+		const collection_Allocator* allocator) {
+	assert((hash == NULL) == (equals == NULL));
+	ConcurrentHashMap* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(ConcurrentHashMap));
+	assert(result != NULL);
+	result->allocator = allocator;
+	result->hashFunction = hash;
+	result->equalsFunction = equals;
+	for (int i = 0; i < STRIPE_COUNT; ++i) {
+		pthread_mutex_init(&result->stripes[i].lock, NULL);
+		atomic_init(&result->stripes[i].size, 0);
+	}
+	result->domain = collection_newEpochDomain(allocator);
+	atomic_init(&result->table, newTable(result, INIT_CAPACITY));
+	return (map_Map) result;
+}
+
+bool map_delMap(map_Map map) {
+	ConcurrentHashMap* concurrentMap = (ConcurrentHashMap*) map;
+	const collection_Allocator* allocator = concurrentMap->allocator;
+	freeTable(concurrentMap, atomic_load(&concurrentMap->table));
+	collection_delEpochDomain(concurrentMap->domain);
+	for (int i = 0; i < STRIPE_COUNT; ++i)
+		pthread_mutex_destroy(&concurrentMap->stripes[i].lock);
+	allocator->deallocate(allocator->context, concurrentMap, sizeof(ConcurrentHashMap));
+	return true;
+}
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of key-value mappings in this map.
+ *
+ * @return the number of key-value mappings in this map
+ */
+int64_t map_size(map_Map map) {
+	ConcurrentHashMap* concurrentMap = (ConcurrentHashMap*) map;
+	int64_t size = 0;
+	for (int i = 0; i < STRIPE_COUNT; ++i)
+		size += atomic_load_explicit(&concurrentMap->stripes[i].size, memory_order_relaxed);
+	return size;
+}
+
+/**
+ * Returns <tt>true</tt> if this map contains no key-value mappings.
+ *
+ * @return <tt>true</tt> if this map contains no key-value mappings
+ */
+bool map_isEmpty(map_Map map) {
+	return map_size(map) == 0;
+}
+
+/**
+ * Returns <tt>true</tt> if this map contains a mapping for the specified
+ * key.
+ *
+ * @param key key whose presence in this map is to be tested
+ * @return <tt>true</tt> if this map contains a mapping for the specified
+ * key
+ */
+bool map_containsKey(map_Map map, const void* key) {
+	ConcurrentHashMap* concurrentMap = (ConcurrentHashMap*) map;
+	uint64_t hash = hashKey(concurrentMap, key);
+	collection_epochEnter(concurrentMap->domain);
+	Table* table = atomic_load_explicit(&concurrentMap->table, memory_order_acquire);
+	bool result = findNode(concurrentMap, table, key, hash) != NULL;
+	collection_epochExit(concurrentMap->domain);
+	return result;
+}
+
+/**
+ * Returns the value to which the specified key is mapped, or
+ * <tt>NULL</tt> if this map contains no mapping for the key.  A return
+ * value of <tt>NULL</tt> does not necessarily indicate that the map
+ * contains no mapping for the key; the {@link #containsKey} operation may
+ * be used to distinguish these two cases.
+ *
+ * @param key the key whose associated value is to be returned
+ * @return the value to which the specified key is mapped, or
+ * <tt>NULL</tt> if this map contains no mapping for the key
+ */
+void* map_get(map_Map map, const void* key) {
+	ConcurrentHashMap* concurrentMap = (ConcurrentHashMap*) map;
+	uint64_t hash = hashKey(concurrentMap, key);
+	collection_epochEnter(concurrentMap->domain);
+	Table* table = atomic_load_explicit(&concurrentMap->table, memory_order_acquire);
+	Node* node = findNode(concurrentMap, table, key, hash);
+	void* result = node == NULL ? NULL : atomic_load_explicit(&node->value, memory_order_acquire);
+	collection_epochExit(concurrentMap->domain);
+	return result;
+}
+
+
+
+// Modification Operations
+
+/**
+ * Associates the specified value with the specified key in this map.  If
+ * the map previously contained a mapping for the key, the old value is
+ * replaced by the specified value and the key already stored is kept.
+ *
+ * @param key key with which the specified value is to be associated
+ * @param value value to be associated with the specified key
+ * @return the previous value associated with <tt>key</tt>, or
+ * <tt>NULL</tt> if there was no mapping for <tt>key</tt>
+ */
+void* map_put(map_Map map, void* key, void* value) {
+	ConcurrentHashMap* concurrentMap = (ConcurrentHashMap*) map;
+	uint64_t hash = hashKey(concurrentMap, key);
+	Stripe* stripe = &concurrentMap->stripes[hash & (STRIPE_COUNT - 1)];
+	pthread_mutex_lock(&stripe->lock);
+	// the table cannot be replaced while a stripe is held
+	Table* table = atomic_load_explicit(&concurrentMap->table, memory_order_relaxed);
+	Node* node = findNode(concurrentMap, table, key, hash);
+	if (node != NULL) {
+		void* result = atomic_exchange_explicit(&node->value, value, memory_order_acq_rel);
+		pthread_mutex_unlock(&stripe->lock);
+		return result;
+	}
+	_Atomic(Node*)* bucket = &table->buckets[hash & (table->capacity - 1)];
+	node = newNode(concurrentMap, hash, key, value,
+			atomic_load_explicit(bucket, memory_order_relaxed));
+	atomic_store_explicit(bucket, node, memory_order_release);
+	int64_t stripeSize = atomic_fetch_add_explicit(&stripe->size, 1, memory_order_relaxed) + 1;
+	// once the stripe is released another writer may replace and retire the
+	// table, so only its address is used afterwards
+	int64_t capacity = table->capacity;
+	pthread_mutex_unlock(&stripe->lock);
+	// every stripe holds about the same share of the mappings
+	if (stripeSize * STRIPE_COUNT * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR)
+		grow(concurrentMap, table);
+	return NULL;
+}
+
+/**
+ * Removes the mapping for a key from this map if it is present.
+ *
+ * @param key key whose mapping is to be removed from the map
+ * @return the previous value associated with <tt>key</tt>, or
+ * <tt>NULL</tt> if there was no mapping for <tt>key</tt>
+ */
+void* map_remove(map_Map map, const void* key) {
+	ConcurrentHashMap* concurrentMap = (ConcurrentHashMap*) map;
+	uint64_t hash = hashKey(concurrentMap, key);
+	Stripe* stripe = &concurrentMap->stripes[hash & (STRIPE_COUNT - 1)];
+	pthread_mutex_lock(&stripe->lock);
+	Table* table = atomic_load_explicit(&concurrentMap->table, memory_order_relaxed);
+	_Atomic(Node*)* link = &table->buckets[hash & (table->capacity - 1)];
+	Node* node;
+	while ((node = atomic_load_explicit(link, memory_order_relaxed)) != NULL
+			&& !(node->hash == hash && keysEqual(concurrentMap, node->key, key)))
+		link = &node->next;
+	if (node == NULL) {
+		pthread_mutex_unlock(&stripe->lock);
+		return NULL;
+	}
+	atomic_store_explicit(link, atomic_load_explicit(&node->next, memory_order_relaxed),
+			memory_order_release);
+	atomic_fetch_sub_explicit(&stripe->size, 1, memory_order_relaxed);
+	void* result = atomic_load_explicit(&node->value, memory_order_relaxed);
+	pthread_mutex_unlock(&stripe->lock);
+	collection_epochRetire(concurrentMap->domain, node, sizeof(Node));
+	return result;
+}
+
+
+
+// Bulk Operations
+
+/**
+ * Copies all of the mappings from the specified map to this map.  The
+ * effect of this call is equivalent to that of calling {@link #put} on
+ * this map once for each mapping in the specified map.
+ *
+ * @param m mappings to be stored in this map
+ */
+void map_putAll(map_Map map, map_Map m) {
+	ConcurrentHashMap* other = (ConcurrentHashMap*) m;
+	collection_epochEnter(other->domain);
+	Table* table = atomic_load_explicit(&other->table, memory_order_acquire);
+	for (int64_t i = 0; i < table->capacity; ++i)
+		for (Node* node = atomic_load_explicit(&table->buckets[i], memory_order_acquire);
+				node != NULL; node = atomic_load_explicit(&node->next, memory_order_acquire))
+			map_put(map, node->key, atomic_load_explicit(&node->value, memory_order_acquire));
+	collection_epochExit(other->domain);
+}
+
+/**
+ * Removes all of the mappings from this map.  The map will be empty
+ * after this call returns.
+ */
+void map_clear(map_Map map) {
+	ConcurrentHashMap* concurrentMap = (ConcurrentHashMap*) map;
+	lockAll(concurrentMap);
+	Table* table = atomic_load_explicit(&concurrentMap->table, memory_order_relaxed);
+	for (int64_t i = 0; i < table->capacity; ++i) {
+		Node* node = atomic_exchange_explicit(&table->buckets[i], NULL, memory_order_acq_rel);
+		while (node != NULL) {
+			Node* next = atomic_load_explicit(&node->next, memory_order_relaxed);
+			collection_epochRetire(concurrentMap->domain, node, sizeof(Node));
+			node = next;
+		}
+	}
+	for (int i = 0; i < STRIPE_COUNT; ++i)
+		atomic_store_explicit(&concurrentMap->stripes[i].size, 0, memory_order_relaxed);
+	unlockAll(concurrentMap);
+}
@@ -0,0 +1,341 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "collection/allocator.h"
+
+#define MAP_IMPLEMENTATION hash
+#include "collection/map/implementations/hashmap.h"
+
+/*
+ * Open addressing with Robin Hood linear probing.  Entries live inline in
+ * one power of two table, so a lookup touches consecutive cache lines and
+ * no entry is ever allocated on its own.  Each entry caches its key's hash
+ * (0 marks an empty slot), which both avoids calling the equals function
+ * on most mismatches and gives the probe distance without rehashing.
+ * Removal shifts the following run back by one slot instead of leaving
+ * tombstones.
+ */
+
+#define INIT_CAPACITY 16
+// the table grows once it would be more than 7/8 full
+#define MAX_LOAD_NUMERATOR 7
+#define MAX_LOAD_DENOMINATOR 8
+
+typedef struct {
+	uint64_t hash;
+	void* key;
+	void* value;
+} Entry;
+
+typedef struct {
+	Entry* table;
+	int64_t size;
+	int64_t capacity; // always a power of two
+	map_HashFunction hashFunction;
+	map_EqualsFunction equalsFunction;
+	const collection_Allocator* allocator;
+} HashMap;
+
+static uint64_t hashPointer(const void* p) {
+	uint64_t h = (uint64_t) (uintptr_t) p;
+	h ^= h >> 33;
+	h *= UINT64_C(0xff51afd7ed558ccd);
+	h ^= h >> 33;
+	return h;
+}
+
+static uint64_t hashKey(HashMap* hashMap, const void* key) {
+	uint64_t h = hashMap->hashFunction == NULL
+			? hashPointer(key) : hashMap->hashFunction(key);
+	return h == 0 ? 1 : h;
+}
+
+static bool keysEqual(HashMap* hashMap, const void* a, const void* b) {
+	return a == b || (hashMap->equalsFunction != NULL && hashMap->equalsFunction(a, b));
+}
+
+static int64_t probeDistance(HashMap* hashMap, uint64_t hash, int64_t index) {
+	return (index - (int64_t) (hash & (hashMap->capacity - 1))) & (hashMap->capacity - 1);
+}
+
+static Entry* allocateTable(HashMap* hashMap, int64_t capacity) {
+	const collection_Allocator* allocator = hashMap->allocator;
+	Entry* table = allocator->allocate(allocator->context, sizeof(Entry) * capacity);
+	assert(table != NULL);
+	memset(table, 0, sizeof(Entry) * capacity);
+	return table;
+}
+
+/*
+ * Places an entry whose key is known not to be in the table.
+ */
+static void insertNew(HashMap* hashMap, Entry entry) {
+	int64_t mask = hashMap->capacity - 1;
+	int64_t index = entry.hash & mask;
+	int64_t distance = 0;
+	for (;; index = (index + 1) & mask, ++distance) {
+		Entry* slot = &hashMap->table[index];
+		if (slot->hash == 0) {
+			*slot = entry;
+			return;
+		}
+		int64_t slotDistance = probeDistance(hashMap, slot->hash, index);
+		if (slotDistance < distance) {
+			// take the slot from the richer entry and carry it onwards
+			Entry displaced = *slot;
+			*slot = entry;
+			entry = displaced;
+			distance = slotDistance;
+		}
+	}
+}
+
+static void resizeTable(HashMap* hashMap, int64_t newCapacity) {
+	Entry* oldTable = hashMap->table;
+	int64_t oldCapacity = hashMap->capacity;
+	hashMap->table = allocateTable(hashMap, newCapacity);
+	hashMap->capacity = newCapacity;
+	for (int64_t i = 0; i < oldCapacity; ++i)
+		if (oldTable[i].hash != 0)
+			insertNew(hashMap, oldTable[i]);
+	hashMap->allocator->deallocate(hashMap->allocator->context, oldTable,
+			sizeof(Entry) * oldCapacity);
+}
+
+/*
+ * Grows the table so it can hold size mappings without exceeding the
+ * maximum load factor.
+ */
+static void ensureCapacity(HashMap* hashMap, int64_t size) {
+	int64_t capacity = hashMap->capacity;
+	while (size * MAX_LOAD_DENOMINATOR > capacity * MAX_LOAD_NUMERATOR)
+		capacity <<= 1;
+	if (capacity != hashMap->capacity)
+		resizeTable(hashMap, capacity);
+}
+
+static int64_t findIndex(HashMap* hashMap, const void* key, uint64_t hash) {
+	int64_t mask = hashMap->capacity - 1;
+	int64_t index = hash & mask;
+	for (int64_t distance = 0;; index = (index + 1) & mask, ++distance) {
+		Entry* slot = &hashMap->table[index];
+		// past this point the key would have displaced the slot's entry
+		if (slot->hash == 0 || probeDistance(hashMap, slot->hash, index) < distance)
+			return -1;
+		if (slot->hash == hash && keysEqual(hashMap, slot->key, key))
+			return index;
+	}
+}
+
+map_Map map_newMap() {
+	return map_newMapWithAllocator(NULL, NULL, &collection_stdAllocator);
+}
+
+map_Map map_newMapWithFunctions(map_HashFunction hash, map_EqualsFunction equals) {
+	return map_newMapWithAllocator(hash, equals, &collection_stdAllocator);
+}
+
+map_Map map_newMapWithAllocator(map_HashFunction hash, map_EqualsFunction equals,
+		const collection_Allocator* allocator) {
+	assert((hash == NULL) == (equals == NULL));
+	HashMap* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(HashMap));
+	assert(result != NULL);
+	result->allocator = allocator;
+	result->hashFunction = hash;
+	result->equalsFunction = equals;
+	result->size = 0;
+	result->capacity = INIT_CAPACITY;
+	result->table = allocateTable(result, INIT_CAPACITY);
+	return (map_Map) result;
+}
+
+bool map_delMap(map_Map map) {
+	HashMap* hashMap = (HashMap*) map;
+	const collection_Allocator* allocator = hashMap->allocator;
+	allocator->deallocate(allocator->context, hashMap->table, sizeof(Entry) * hashMap->capacity);
+	allocator->deallocate(allocator->context, hashMap, sizeof(HashMap));
+	return true;
+}
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of key-value mappings in this map.
+ *
+ * @return the number of key-value mappings in this map
+ */
+int64_t map_size(map_Map map) {
+	HashMap* hashMap = (HashMap*) map;
+	return hashMap->size;
+}
+
+/**
+ * Returns <tt>true</tt> if this map contains no key-value mappings.
+ *
+ * @return <tt>true</tt> if this map contains no key-value mappings
+ */
+bool map_isEmpty(map_Map map) {
+	HashMap* hashMap = (HashMap*) map;
+	return hashMap->size == 0;
+}
+
+/**
+ * Returns <tt>true</tt> if this map contains a mapping for the specified
+ * key.
+ *
+ * @param key key whose presence in this map is to be tested
+ * @return <tt>true</tt> if this map contains a mapping for the specified
+ * key
+ */
+bool map_containsKey(map_Map map, const void* key) {
+	HashMap* hashMap = (HashMap*) map;
+	return findIndex(hashMap, key, hashKey(hashMap, key)) >= 0;
+}
+
+/**
+ * Returns the value to which the specified key is mapped, or
+ * <tt>NULL</tt> if this map contains no mapping for the key.  A return
+ * value of <tt>NULL</tt> does not necessarily indicate that the map
+ * contains no mapping for the key; the {@link #containsKey} operation may
+ * be used to distinguish these two cases.
+ *
+ * @param key the key whose associated value is to be returned
+ * @return the value to which the specified key is mapped, or
+ * <tt>NULL</tt> if this map contains no mapping for the key
+ */
+void* map_get(map_Map map, const void* key) {
+	HashMap* hashMap = (HashMap*) map;
+	int64_t index = findIndex(hashMap, key, hashKey(hashMap, key));
+	return index < 0 ? NULL : hashMap->table[index].value;
+}
+
+
+
+// Modification Operations
+
+/**
+ * Associates the specified value with the specified key in this map.  If
+ * the map previously contained a mapping for the key, the old value is
+ * replaced by the specified value and the key already stored is kept.
+ *
+ * @param key key with which the specified value is to be associated
+ * @param value value to be associated with the specified key
+ * @return the previous value associated with <tt>key</tt>, or
+ * <tt>NULL</tt> if there was no mapping for <tt>key</tt>
+ */
+void* map_put(map_Map map, void* key, void* value) {
+	HashMap* hashMap = (HashMap*) map;
+	uint64_t hash = hashKey(hashMap, key);
+	int64_t index = findIndex(hashMap, key, hash);
+	if (index >= 0) {
+		void* result = hashMap->table[index].value;
+		hashMap->table[index].value = value;
+		return result;
+	}
+	ensureCapacity(hashMap, hashMap->size + 1);
+	Entry entry = { hash, key, value };
+	insertNew(hashMap, entry);
+	++hashMap->size;
+	return NULL;
+}
+
+/**
+ * Removes the mapping for a key from this map if it is present.
+ *
+ * @param key key whose mapping is to be removed from the map
+ * @return the previous value associated with <tt>key</tt>, or
+ * <tt>NULL</tt> if there was no mapping for <tt>key</tt>
+ */
+void* map_remove(map_Map map, const void* key) {
+	HashMap* hashMap = (HashMap*) map;
+	int64_t index = findIndex(hashMap, key, hashKey(hashMap, key));
+	if (index < 0)
+		return NULL;
+	void* result = hashMap->table[index].value;
+	// shift the rest of the run back over the removed entry
+	int64_t mask = hashMap->capacity - 1;
+	int64_t next = (index + 1) & mask;
+	while (hashMap->table[next].hash != 0
+			&& probeDistance(hashMap, hashMap->table[next].hash, next) > 0) {
+		hashMap->table[index] = hashMap->table[next];
+		index = next;
+		next = (next + 1) & mask;
+	}
+	memset(&hashMap->table[index], 0, sizeof(Entry));
+	--hashMap->size;
+	return result;
+}
+
+
+
+// Bulk Operations
+
+/**
+ * Copies all of the mappings from the specified map to this map.  The
+ * effect of this call is equivalent to that of calling {@link #put} on
+ * this map once for each mapping in the specified map.  The table is
+ * grown once up front rather than step by step.
+ *
+ * @param m mappings to be stored in this map
+ */
+void map_putAll(map_Map map, map_Map m) {
+	HashMap* hashMap = (HashMap*) map;
+	HashMap* other = (HashMap*) m;
+	ensureCapacity(hashMap, hashMap->size + other->size);
+	bool sameHash = hashMap->hashFunction == other->hashFunction;
+	for (int64_t i = 0; i < other->capacity; ++i) {
+		Entry* entry = &other->table[i];
+		if (entry->hash == 0)
+			continue;
+		uint64_t hash = sameHash ? entry->hash : hashKey(hashMap, entry->key);
+		int64_t index = findIndex(hashMap, entry->key, hash);
+		if (index >= 0)
+			hashMap->table[index].value = entry->value;
+		else {
+			Entry copy = { hash, entry->key, entry->value };
+			insertNew(hashMap, copy);
+			++hashMap->size;
+		}
+	}
+}
+
+/**
+ * Removes all of the mappings from this map.  The map will be empty
+ * after this call returns.
+ */
+void map_clear(map_Map map) {
+	HashMap* hashMap = (HashMap*) map;
+	memset(hashMap->table, 0, sizeof(Entry) * hashMap->capacity);
+	hashMap->size = 0;
+}
@@ -0,0 +1,12 @@
+ifeq ($(BASE_DIR),)
+abort:   ## This MUST be the first target :( ugly
+	@echo Make must be run from the root of the project && false
+endif
+
+all: hashmap.o concurrenthashmap.o
+
+hashmap.o: $(BASE_DIR)/include/collection/map/implementations/hashmap.h hashmap.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include hashmap.c
+
+concurrenthashmap.o: $(BASE_DIR)/include/collection/map/implementations/concurrenthashmap.h concurrenthashmap.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include concurrenthashmap.c
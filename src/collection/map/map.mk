@@ -0,0 +1,18 @@
+ifeq ($(BASE_DIR),)
+abort:   ## This MUST be the first target :( ugly
+	@echo Make must be run from the root of the project && false
+endif
+
+CURRENT_DIR:=$(CURRENT_DIR)/map
+
+export MAP_IMPLEMENTATIONS_OBJ:= implementations/hashmap.o implementations/concurrenthashmap.o
+
+all: implementations libmap.so
+
+.PHONY: implementations
+# objects are left out so that make does not try to rebuild them from here
+implementations: $(filter-out %.o,$(wildcard implementations/*))
+	$(MAKE) -C $(BASE_DIR)/$(CURRENT_DIR)/implementations -f implementations.mk
+
+libmap.so: implementations
+	gcc -shared $(COLLECTION_LDFLAGS) -o libmap.so $(MAP_IMPLEMENTATIONS_OBJ) $(COLLECTION_OBJ) -lpthread
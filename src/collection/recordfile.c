@@ -0,0 +1,220 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "collection/recordfile.h"
+
+#define RECORD_FILE_MAGIC "CLRECORD"
+#define RECORD_FILE_VERSION 2
+#define RECORD_FILE_BYTE_ORDER 0x01020304u
+
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint64_t recordSize;
+	uint64_t count;
+	uint64_t typeTag; // hash of the name of the record type
+	uint8_t reserved[24];
+} RecordFileHeader;
+
+_Static_assert(sizeof(RecordFileHeader) == 64, "record file header must be 64 bytes");
+
+/*
+ * 64 bit FNV-1a hash of the name of a record type.
+ */
+static uint64_t typeTagOf(const char* type) {
+	uint64_t hash = UINT64_C(14695981039346656037);
+	for (const unsigned char* p = (const unsigned char*) type; *p != '\0'; ++p) {
+		hash ^= *p;
+		hash *= UINT64_C(1099511628211);
+	}
+	return hash;
+}
+
+/*
+ * Writes all of buffer, retrying short writes.
+ */
+static bool writeFully(int fd, const void* buffer, size_t length) {
+	const char* p = buffer;
+	while (length > 0) {
+		ssize_t written = write(fd, p, length);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		p += written;
+		length -= written;
+	}
+	return true;
+}
+
+/*
+ * Flushes the directory holding path to disk, so that a file renamed into
+ * it is still there after a crash.
+ */
+static bool syncDirectory(const char* path) {
+	const char* slash = strrchr(path, '/');
+	char* directory = slash == NULL ? strdup(".")
+			: slash == path ? strdup("/") : strndup(path, slash - path);
+	assert(directory != NULL);
+	int fd = open(directory, O_RDONLY | O_DIRECTORY);
+	free(directory);
+	if (fd < 0)
+		return false;
+	bool synced = fsync(fd) == 0;
+	int error = errno;
+	close(fd);
+	errno = error;
+	return synced;
+}
+
+/**
+ * Writes <tt>count</tt> records of <tt>recordSize</tt> bytes to the file
+ * at <tt>path</tt>.  The records are written to a uniquely named
+ * temporary file next to it, which is flushed to disk and then renamed
+ * over it, so processes that have the old file mapped keep seeing the old
+ * records, a crash leaves either the old or the new file under
+ * <tt>path</tt>, never a partial one, and of concurrent writers of
+ * <tt>path</tt> the last to rename wins.
+ *
+ * @param path file to create or replace
+ * @param type name of the record type, checked by {@link #mapRecordFile}
+ * @param records the records to write
+ * @param recordSize size of one record in bytes
+ * @param count number of records
+ * @return <tt>true</tt> once the file is written and its directory entry
+ * flushed to disk, <tt>false</tt> if an I/O error occurred, in which case
+ * <tt>errno</tt> describes it
+ */
+bool collection_writeRecordFile(const char* path, const char* type,
+		const void* records, size_t recordSize, int64_t count) {
+	assert(recordSize > 0 && count >= 0);
+	RecordFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, RECORD_FILE_MAGIC, sizeof(header.magic));
+	header.version = RECORD_FILE_VERSION;
+	header.byteOrder = RECORD_FILE_BYTE_ORDER;
+	header.recordSize = recordSize;
+	header.count = count;
+	header.typeTag = typeTagOf(type);
+	// a name of its own, so that concurrent writers of path do not write
+	// to the same temporary file
+	size_t pathLength = strlen(path);
+	char* temporary = malloc(pathLength + sizeof(".XXXXXX"));
+	assert(temporary != NULL);
+	memcpy(temporary, path, pathLength);
+	memcpy(temporary + pathLength, ".XXXXXX", sizeof(".XXXXXX"));
+	bool written = false;
+	int fd = mkstemp(temporary);
+	if (fd >= 0) {
+		// mkstemp creates the file readable by its owner only
+		written = fchmod(fd, 0644) == 0
+				&& writeFully(fd, &header, sizeof(header))
+				&& writeFully(fd, records, recordSize * count)
+				&& fsync(fd) == 0;
+		written = close(fd) == 0 && written;
+		written = written && rename(temporary, path) == 0;
+		if (!written) {
+			int error = errno;
+			unlink(temporary);
+			errno = error;
+		} else
+			written = syncDirectory(path);
+	}
+	free(temporary);
+	return written;
+}
+
+/**
+ * Maps the record file at <tt>path</tt> read-only into memory.
+ *
+ * @param file receives the mapping and the location and number of its
+ * records
+ * @param path file to map
+ * @param type name of the record type, which must match the name the file
+ * was written with
+ * @param recordSize size of one record in bytes, which must match the
+ * size recorded in the file
+ * @return <tt>true</tt> if the file was mapped, <tt>false</tt> if it could
+ * not be opened or mapped, or is not a record file of
+ * <tt>recordSize</tt> byte records of <tt>type</tt> written on a machine
+ * of the same byte order
+ */
+bool collection_mapRecordFile(collection_RecordFile* file, const char* path,
+		const char* type, size_t recordSize) {
+	assert(recordSize > 0);
+	memset(file, 0, sizeof(*file));
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat status;
+	if (fstat(fd, &status) != 0 || status.st_size < (off_t) sizeof(RecordFileHeader)) {
+		close(fd);
+		return false;
+	}
+	size_t length = status.st_size;
+	void* mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return false;
+	const RecordFileHeader* header = mapping;
+	if (memcmp(header->magic, RECORD_FILE_MAGIC, sizeof(header->magic)) != 0
+			|| header->version != RECORD_FILE_VERSION
+			|| header->byteOrder != RECORD_FILE_BYTE_ORDER
+			|| header->recordSize != recordSize
+			|| header->typeTag != typeTagOf(type)
+			|| header->count > (length - sizeof(RecordFileHeader)) / recordSize) {
+		munmap(mapping, length);
+		return false;
+	}
+	file->mapping = mapping;
+	file->length = length;
+	file->records = (const char*) mapping + sizeof(RecordFileHeader);
+	file->count = header->count;
+	return true;
+}
+
+/**
+ * Unmaps a file mapped by {@link #mapRecordFile}.  Its records must not
+ * be used afterwards.
+ */
+void collection_unmapRecordFile(collection_RecordFile* file) {
+	if (file->mapping != NULL)
+		munmap(file->mapping, file->length);
+	memset(file, 0, sizeof(*file));
+}
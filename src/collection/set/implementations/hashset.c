@@ -0,0 +1,456 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "collection/allocator.h"
+
+#define SET_IMPLEMENTATION hash
+#include "collection/set/implementations/hashset.h"
+
+/*
+ * Swiss table layout: the slots are split into groups of 16, and every
+ * slot has a control byte that is either EMPTY, DELETED or, for a full
+ * slot, the low 7 bits of its element's hash.  A probe loads the 16
+ * control bytes of a group and compares them all at once against the
+ * hash bits being looked for, so only slots whose 7 bits match are ever
+ * compared as elements.  A probe stops at the first group that still has
+ * an EMPTY slot.
+ *
+ * The group to start at is taken from the high bits of the hash by a
+ * multiply-shift range reduction, so the number of groups need not be a
+ * power of two and set_reserve can size the table tightly.  Slot pointers
+ * and control bytes share one allocation, 9 bytes per slot.
+ */
+
+#define GROUP_SIZE 16
+#define CTRL_EMPTY ((int8_t) -128)
+#define CTRL_DELETED ((int8_t) -2)
+// the table is rebuilt once it would be more than 7/8 full
+#define MAX_LOAD_NUMERATOR 7
+#define MAX_LOAD_DENOMINATOR 8
+
+typedef struct {
+	void** slots;
+	int8_t* ctrl; // stored right after the slots
+	int64_t groups;
+	int64_t size;
+	int64_t growthLeft; // EMPTY slots that may still be filled before a rebuild
+	set_HashFunction hashFunction;
+	set_EqualsFunction equalsFunction;
+	const collection_Allocator* allocator;
+} HashSet;
+
+
+
+// Group Matching
+
+/*
+ * Each returns a bit mask with bit i set when control byte i of the group
+ * satisfies the test.
+ */
+#ifdef __SSE2__
+
+static inline uint32_t matchByte(const int8_t* group, int8_t b) {
+	__m128i ctrl = _mm_loadu_si128((const __m128i*) group);
+	return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(b)));
+}
+
+static inline uint32_t matchEmptyOrDeleted(const int8_t* group) {
+	__m128i ctrl = _mm_loadu_si128((const __m128i*) group);
+	return (uint32_t) _mm_movemask_epi8(_mm_cmplt_epi8(ctrl, _mm_set1_epi8(-1)));
+}
+
+#else
+
+static inline uint32_t matchByte(const int8_t* group, int8_t b) {
+	uint32_t mask = 0;
+	for (int i = 0; i < GROUP_SIZE; ++i)
+		mask |= (uint32_t) (group[i] == b) << i;
+	return mask;
+}
+
+static inline uint32_t matchEmptyOrDeleted(const int8_t* group) {
+	uint32_t mask = 0;
+	for (int i = 0; i < GROUP_SIZE; ++i)
+		mask |= (uint32_t) (group[i] < -1) << i;
+	return mask;
+}
+
+#endif
+
+static inline uint32_t matchEmpty(const int8_t* group) {
+	return matchByte(group, CTRL_EMPTY);
+}
+
+
+
+// Table Management
+
+static uint64_t mixHash(uint64_t h) {
+	h ^= h >> 33;
+	h *= UINT64_C(0xff51afd7ed558ccd);
+	h ^= h >> 33;
+	return h;
+}
+
+static uint64_t hashElement(HashSet* hashSet, const void* e) {
+	if (hashSet->hashFunction == NULL)
+		return mixHash((uint64_t) (uintptr_t) e);
+	return mixHash(hashSet->hashFunction(e));
+}
+
+static bool elementsEqual(HashSet* hashSet, const void* a, const void* b) {
+	return a == b || (hashSet->equalsFunction != NULL && hashSet->equalsFunction(a, b));
+}
+
+static int64_t firstGroup(HashSet* hashSet, uint64_t hash) {
+	return (int64_t) (((unsigned __int128) hash * (uint64_t) hashSet->groups) >> 64);
+}
+
+static int64_t nextGroup(HashSet* hashSet, int64_t group) {
+	return group + 1 == hashSet->groups ? 0 : group + 1;
+}
+
+static int8_t hashBits(uint64_t hash) {
+	return (int8_t) (hash & 0x7f);
+}
+
+static int64_t capacityOf(HashSet* hashSet) {
+	return hashSet->groups * GROUP_SIZE;
+}
+
+static int64_t maxLoad(int64_t capacity) {
+	return capacity / MAX_LOAD_DENOMINATOR * MAX_LOAD_NUMERATOR;
+}
+
+static int64_t groupsFor(int64_t size) {
+	int64_t capacity = (size * MAX_LOAD_DENOMINATOR + MAX_LOAD_NUMERATOR - 1) / MAX_LOAD_NUMERATOR;
+	int64_t groups = (capacity + GROUP_SIZE - 1) / GROUP_SIZE;
+	while (maxLoad(groups * GROUP_SIZE) < size)
+		++groups;
+	return groups > 0 ? groups : 1;
+}
+
+static void allocateTable(HashSet* hashSet, int64_t groups) {
+	const collection_Allocator* allocator = hashSet->allocator;
+	int64_t capacity = groups * GROUP_SIZE;
+	hashSet->slots = allocator->allocate(allocator->context,
+			(sizeof(void*) + 1) * capacity);
+	assert(hashSet->slots != NULL);
+	hashSet->ctrl = (int8_t*) (hashSet->slots + capacity);
+	memset(hashSet->ctrl, CTRL_EMPTY, capacity);
+	hashSet->groups = groups;
+	hashSet->growthLeft = maxLoad(capacity) - hashSet->size;
+}
+
+static void freeTable(HashSet* hashSet) {
+	hashSet->allocator->deallocate(hashSet->allocator->context, hashSet->slots,
+			(sizeof(void*) + 1) * capacityOf(hashSet));
+}
+
+/*
+ * Returns the first EMPTY or DELETED slot on the probe sequence of hash.
+ */
+static int64_t findFreeSlot(HashSet* hashSet, uint64_t hash) {
+	int64_t group = firstGroup(hashSet, hash);
+	for (;; group = nextGroup(hashSet, group)) {
+		uint32_t mask = matchEmptyOrDeleted(hashSet->ctrl + group * GROUP_SIZE);
+		if (mask != 0)
+			return group * GROUP_SIZE + __builtin_ctz(mask);
+	}
+}
+
+static void placeElement(HashSet* hashSet, int64_t index, void* e, uint64_t hash) {
+	if (hashSet->ctrl[index] == CTRL_EMPTY)
+		--hashSet->growthLeft;
+	hashSet->ctrl[index] = hashBits(hash);
+	hashSet->slots[index] = e;
+	++hashSet->size;
+}
+
+static void rebuildTable(HashSet* hashSet, int64_t groups) {
+	void** oldSlots = hashSet->slots;
+	int8_t* oldCtrl = hashSet->ctrl;
+	int64_t oldCapacity = capacityOf(hashSet);
+	int64_t size = hashSet->size;
+	hashSet->size = 0;
+	allocateTable(hashSet, groups);
+	for (int64_t i = 0; i < oldCapacity; ++i)
+		if (oldCtrl[i] >= 0) {
+			uint64_t hash = hashElement(hashSet, oldSlots[i]);
+			placeElement(hashSet, findFreeSlot(hashSet, hash), oldSlots[i], hash);
+		}
+	assert(hashSet->size == size);
+	hashSet->allocator->deallocate(hashSet->allocator->context, oldSlots,
+			(sizeof(void*) + 1) * oldCapacity);
+}
+
+/*
+ * Makes room for one more element in an EMPTY slot: the table grows by
+ * half if it is mostly live elements and is rebuilt at the same size if it
+ * is mostly DELETED slots.  Growing by less than double keeps a set that
+ * is never reserved within 1.5 times the size of a reserved one, at the
+ * cost of a few more rebuilds; the range reduction does not need a power
+ * of two.
+ */
+static void growForInsert(HashSet* hashSet) {
+	if (hashSet->size * 2 > maxLoad(capacityOf(hashSet)))
+		rebuildTable(hashSet, hashSet->groups + hashSet->groups / 2 + 1);
+	else
+		rebuildTable(hashSet, hashSet->groups);
+}
+
+static int64_t findIndex(HashSet* hashSet, const void* o, uint64_t hash) {
+	int8_t bits = hashBits(hash);
+	int64_t group = firstGroup(hashSet, hash);
+	for (int64_t probes = 0; probes < hashSet->groups; ++probes) {
+		const int8_t* ctrl = hashSet->ctrl + group * GROUP_SIZE;
+		for (uint32_t mask = matchByte(ctrl, bits); mask != 0; mask &= mask - 1) {
+			int64_t index = group * GROUP_SIZE + __builtin_ctz(mask);
+			if (elementsEqual(hashSet, hashSet->slots[index], o))
+				return index;
+		}
+		if (matchEmpty(ctrl) != 0)
+			return -1;
+		group = nextGroup(hashSet, group);
+	}
+	return -1;
+}
+
+static bool addHashed(HashSet* hashSet, void* e, uint64_t hash) {
+	if (findIndex(hashSet, e, hash) >= 0)
+		return false;
+	int64_t index = findFreeSlot(hashSet, hash);
+	if (hashSet->ctrl[index] == CTRL_EMPTY && hashSet->growthLeft == 0) {
+		growForInsert(hashSet);
+		index = findFreeSlot(hashSet, hash);
+	}
+	placeElement(hashSet, index, e, hash);
+	return true;
+}
+
+set_Set set_newSet() {
+	return set_newSetWithAllocator(NULL, NULL, &collection_stdAllocator);
+}
+
+set_Set set_newSetWithFunctions(set_HashFunction hash, set_EqualsFunction equals) {
+	return set_newSetWithAllocator(hash, equals, &collection_stdAllocator);
+}
+
+set_Set set_newSetWithAllocator(set_HashFunction hash, set_EqualsFunction equals,
+		const collection_Allocator* allocator) {
+	assert((hash == NULL) == (equals == NULL));
+	HashSet* result = NULL;
+	result = allocator->allocate(allocator->context, sizeof(HashSet));
+	assert(result != NULL);
+	result->hashFunction = hash;
+	result->equalsFunction = equals;
+	result->allocator = allocator;
+	result->size = 0;
+	allocateTable(result, 1);
+	return (set_Set) result;
+}
+
+bool set_delSet(set_Set set) {
+	HashSet* hashSet = (HashSet*) set;
+	freeTable(hashSet);
+	hashSet->allocator->deallocate(hashSet->allocator->context, hashSet, sizeof(HashSet));
+	return true;
+}
+
+/**
+ * Sizes the table so that it can hold at least <tt>minSize</tt> elements
+ * without growing.  The table uses 9 bytes per slot and is filled up to
+ * 7/8, so a set reserved for 1M pointers takes about 10 MB.  A set that
+ * grows by {@link #add} alone grows its table by half each time, and so
+ * takes up to 1.5 times as much; reserve to get the tight footprint.
+ *
+ * @param minSize the number of elements to make room for
+ */
+void set_reserve(set_Set set, int64_t minSize) {
+	HashSet* hashSet = (HashSet*) set;
+	int64_t groups = groupsFor(minSize);
+	if (groups > hashSet->groups)
+		rebuildTable(hashSet, groups);
+}
+
+
+
+// Query Operations
+
+/**
+ * Returns the number of elements in this set.
+ *
+ * @return the number of elements in this set
+ */
+int64_t set_size(set_Set set) {
+	HashSet* hashSet = (HashSet*) set;
+	return hashSet->size;
+}
+
+/**
+ * Returns <tt>true</tt> if this set contains no elements.
+ *
+ * @return <tt>true</tt> if this set contains no elements
+ */
+bool set_isEmpty(set_Set set) {
+	HashSet* hashSet = (HashSet*) set;
+	return hashSet->size == 0;
+}
+
+/**
+ * Returns <tt>true</tt> if this set contains the specified element.
+ *
+ * @param o element whose presence in this set is to be tested
+ * @return <tt>true</tt> if this set contains the specified element
+ */
+bool set_contains(set_Set set, const void* o) {
+	HashSet* hashSet = (HashSet*) set;
+	return findIndex(hashSet, o, hashElement(hashSet, o)) >= 0;
+}
+
+/**
+ * Advances an iteration over the elements of this set.  Start with
+ * <tt>*position</tt> set to 0 and call repeatedly; each call stores the
+ * next element in <tt>*element</tt>.  Elements are returned in no
+ * particular order.  The behavior is undefined if the set is modified
+ * during the iteration, except through {@link #remove} of the element
+ * just returned.
+ *
+ * @param position iteration state, 0 to start
+ * @param element receives the next element
+ * @return <tt>false</tt> once every element has been returned
+ */
+bool set_iterate(set_Set set, int64_t* position, void** element) {
+	HashSet* hashSet = (HashSet*) set;
+	int64_t capacity = capacityOf(hashSet);
+	for (int64_t i = *position; i < capacity; ++i)
+		if (hashSet->ctrl[i] >= 0) {
+			*element = hashSet->slots[i];
+			*position = i + 1;
+			return true;
+		}
+	*position = capacity;
+	return false;
+}
+
+
+
+// Modification Operations
+
+/**
+ * Adds the specified element to this set if it is not already present.
+ *
+ * @param e element to be added to this set
+ * @return <tt>true</tt> if this set did not already contain the specified
+ * element
+ */
+bool set_add(set_Set set, void* e) {
+	HashSet* hashSet = (HashSet*) set;
+	return addHashed(hashSet, e, hashElement(hashSet, e));
+}
+
+/**
+ * Removes the specified element from this set if it is present.
+ *
+ * @param o element to be removed from this set, if present
+ * @return <tt>true</tt> if this set contained the specified element
+ */
+bool set_remove(set_Set set, const void* o) {
+	HashSet* hashSet = (HashSet*) set;
+	int64_t index = findIndex(hashSet, o, hashElement(hashSet, o));
+	if (index < 0)
+		return false;
+	// A group that still has an EMPTY slot has never been full, so no probe
+	// has gone past it and the slot can become EMPTY again.
+	int64_t group = index / GROUP_SIZE;
+	if (matchEmpty(hashSet->ctrl + group * GROUP_SIZE) != 0) {
+		hashSet->ctrl[index] = CTRL_EMPTY;
+		++hashSet->growthLeft;
+	} else
+		hashSet->ctrl[index] = CTRL_DELETED;
+	--hashSet->size;
+	return true;
+}
+
+
+
+// Bulk Operations
+
+/**
+ * Returns <tt>true</tt> if this set contains all of the elements of the
+ * specified array.
+ *
+ * @param arr elements to be checked for containment in this set
+ * @return <tt>true</tt> if this set contains all of the elements of the
+ * specified array
+ * @see #contains(void*)
+ */
+bool set_containsAll(set_Set set, void* arr[], size_t arrLength) {
+	HashSet* hashSet = (HashSet*) set;
+	for (size_t i = 0; i < arrLength; ++i)
+		if (findIndex(hashSet, arr[i], hashElement(hashSet, arr[i])) < 0)
+			return false;
+	return true;
+}
+
+/**
+ * Adds all of the elements in the specified array to this set if they're
+ * not already present.  The table is grown once up front rather than
+ * step by step.
+ *
+ * @param arr elements to be added to this set
+ * @return <tt>true</tt> if this set changed as a result of the call
+ * @see #add(void*)
+ */
+bool set_addAll(set_Set set, void* arr[], size_t arrLength) {
+	HashSet* hashSet = (HashSet*) set;
+	set_reserve(set, hashSet->size + arrLength);
+	bool changed = false;
+	for (size_t i = 0; i < arrLength; ++i)
+		changed |= addHashed(hashSet, arr[i], hashElement(hashSet, arr[i]));
+	return changed;
+}
+
+/**
+ * Removes all of the elements from this set.  The set will be empty after
+ * this call returns.
+ */
+void set_clear(set_Set set) {
+	HashSet* hashSet = (HashSet*) set;
+	int64_t capacity = capacityOf(hashSet);
+	memset(hashSet->ctrl, CTRL_EMPTY, capacity);
+	hashSet->size = 0;
+	hashSet->growthLeft = maxLoad(capacity);
+}
@@ -0,0 +1,9 @@
+ifeq ($(BASE_DIR),)
+abort:   ## This MUST be the first target :( ugly
+	@echo Make must be run from the root of the project && false
+endif
+
+all: hashset.o
+
+hashset.o: $(BASE_DIR)/include/collection/set/implementations/hashset.h hashset.c
+	gcc -c -Wall -fpic $(COLLECTION_CFLAGS) -I$(BASE_DIR)/include hashset.c
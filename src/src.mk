@@ -7,5 +7,6 @@ CURRENT_DIR:=$(CURRENT_DIR)/src
 
 all: collection
 
-collection: collection/*
+# objects are left out so that make does not try to rebuild them from here
+collection: $(filter-out %.o,$(wildcard collection/*))
 	$(MAKE) -C $(BASE_DIR)/$(CURRENT_DIR)/collection -f collection.mk
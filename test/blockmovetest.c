@@ -0,0 +1,198 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Checks the structural changes of the ArrayList that are built on its
+ * block move against a naive array.  For every root of up to MAX_SIZE
+ * elements, whole or seen through a view or a view of a view, the test
+ * inserts every number of elements up to MAX_SIZE at every index with
+ * addAllAt, so that the inserted run is often longer than the tail it
+ * shifts, removes every window with removeRange, and opens every gap
+ * with insertGap and fills it with set.  Roots are made with both
+ * newList and newSmallList, so inline storage and growing the array are
+ * covered as well.
+ *
+ * Exits with status 1 if a list differs from the reference.
+ *
+ * usage: blockmovetest
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LIST_IMPLEMENTATION array
+#include "collection/list/implementations/arraylist.h"
+
+#define MAX_SIZE 12 // beyond the initial capacity of a list
+#define INSERTED 1000 // first value of the inserted elements
+
+enum { ADD_ALL_AT, REMOVE_RANGE, INSERT_GAP };
+
+static const char* const operationNames[] = { "addAllAt", "removeRange", "insertGap" };
+
+// the list an operation is applied to: the root, a view or a view of a view
+typedef struct {
+	int64_t size; // of the root
+	bool small; // made with newSmallList
+	int depth; // 0 for the root itself
+	int64_t from, to; // window of the outer view in the root
+	int64_t innerFrom, innerTo; // window of the inner view in the outer view
+} Target;
+
+static uint64_t checks;
+static uint64_t failures;
+
+static void* value(intptr_t v) {
+	return (void*) v;
+}
+
+/*
+ * Compares list with the n elements of expected.
+ */
+static bool sameElements(list_List list, const intptr_t* expected, int64_t n) {
+	if (list_size(list) != n)
+		return false;
+	for (int64_t i = 0; i < n; ++i)
+		if (list_get(list, i) != value(expected[i]))
+			return false;
+	return true;
+}
+
+static void report(const Target* t, int operation, int64_t a, int64_t b) {
+	if (failures++ < 10)
+		fprintf(stderr, "%s(%ld, %ld) on %s root of %ld, depth %d [%ld, %ld) [%ld, %ld)\n",
+				operationNames[operation], (long) a, (long) b, t->small ? "small" : "plain",
+				(long) t->size, t->depth, (long) t->from, (long) t->to,
+				(long) t->innerFrom, (long) t->innerTo);
+}
+
+/*
+ * Applies operation with arguments a and b to a fresh list described by t,
+ * applies it to a naive copy of the root, and compares the root and the
+ * target with the copy.
+ */
+static void check(const Target* t, int operation, int64_t a, int64_t b) {
+	intptr_t expected[3 * MAX_SIZE];
+	void* inserted[MAX_SIZE];
+	list_List root = t->small ? list_newSmallList() : list_newList();
+	for (int64_t i = 0; i < t->size; ++i) {
+		expected[i] = i + 1;
+		list_add(root, value(i + 1));
+	}
+	list_List outer = t->depth > 0 ? list_subList(root, t->from, t->to) : NULL;
+	list_List inner = t->depth > 1 ? list_subList(outer, t->innerFrom, t->innerTo) : NULL;
+	list_List target = inner != NULL ? inner : outer != NULL ? outer : root;
+	// offset and size of the target in the root
+	int64_t offset = t->depth > 0 ? t->from : 0;
+	offset += t->depth > 1 ? t->innerFrom : 0;
+	int64_t targetSize = list_size(target);
+	int64_t n = t->size;
+	bool gapIsNull = true;
+	switch (operation) {
+	case ADD_ALL_AT:
+		for (int64_t i = 0; i < b; ++i)
+			inserted[i] = value(INSERTED + i);
+		list_addAllAt(target, a, inserted, b);
+		memmove(&expected[offset + a + b], &expected[offset + a], sizeof(intptr_t) * (n - offset - a));
+		for (int64_t i = 0; i < b; ++i)
+			expected[offset + a + i] = INSERTED + i;
+		n += b;
+		targetSize += b;
+		break;
+	case REMOVE_RANGE:
+		list_removeRange(target, a, b);
+		memmove(&expected[offset + a], &expected[offset + b], sizeof(intptr_t) * (n - offset - b));
+		n -= b - a;
+		targetSize -= b - a;
+		break;
+	case INSERT_GAP:
+		list_insertGap(target, a, b);
+		for (int64_t i = 0; i < b; ++i) {
+			gapIsNull = gapIsNull && list_get(target, a + i) == NULL;
+			list_set(target, a + i, value(INSERTED + i));
+		}
+		memmove(&expected[offset + a + b], &expected[offset + a], sizeof(intptr_t) * (n - offset - a));
+		for (int64_t i = 0; i < b; ++i)
+			expected[offset + a + i] = INSERTED + i;
+		n += b;
+		targetSize += b;
+		break;
+	}
+	++checks;
+	if (!gapIsNull || !sameElements(target, &expected[offset], targetSize)
+			|| (target != root && !sameElements(root, expected, n)))
+		report(t, operation, a, b);
+	if (inner != NULL)
+		list_delList(inner);
+	if (outer != NULL)
+		list_delList(outer);
+	list_delList(root);
+}
+
+/*
+ * Applies every operation with every valid argument to the target t.
+ */
+static void checkTarget(const Target* t) {
+	int64_t size = t->depth == 0 ? t->size
+			: t->depth == 1 ? t->to - t->from : t->innerTo - t->innerFrom;
+	for (int64_t index = 0; index <= size; ++index)
+		for (int64_t n = 0; n <= MAX_SIZE; ++n) {
+			check(t, ADD_ALL_AT, index, n);
+			check(t, INSERT_GAP, index, n);
+		}
+	for (int64_t from = 0; from <= size; ++from)
+		for (int64_t to = from; to <= size; ++to)
+			check(t, REMOVE_RANGE, from, to);
+}
+
+int main(int argc, char* argv[]) {
+	Target t;
+	memset(&t, 0, sizeof(t));
+	for (int small = 0; small < 2; ++small)
+		for (t.size = 0; t.size <= MAX_SIZE; ++t.size) {
+			t.small = small;
+			t.depth = 0;
+			checkTarget(&t);
+			for (t.from = 0; t.from <= t.size; ++t.from)
+				for (t.to = t.from; t.to <= t.size; ++t.to) {
+					t.depth = 1;
+					checkTarget(&t);
+					// a few inner windows: whole, and trimmed at either end
+					t.depth = 2;
+					int64_t outerSize = t.to - t.from;
+					for (t.innerFrom = 0; t.innerFrom <= 1 && t.innerFrom <= outerSize; ++t.innerFrom)
+						for (t.innerTo = outerSize; t.innerTo >= outerSize - 1 && t.innerTo >= t.innerFrom; --t.innerTo)
+							checkTarget(&t);
+					t.innerFrom = t.innerTo = 0;
+				}
+			t.from = t.to = 0;
+		}
+	fprintf(stderr, "block moves %s (%lu checks)\n",
+			failures == 0 ? "ok" : "FAILED", (unsigned long) checks);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Randomized test of the positional operations of a list implementation
+ * against a plain array.  The list grows and shrinks through a series of
+ * target sizes while addAt, removeAt, removeRange, addAllAt and set are
+ * applied at random positions, either to the list itself or through a
+ * view or a view of a view.  The contents are compared with the reference
+ * after every operation on the list or view that was changed, and in
+ * full, through get and nextSpan, at the end of every phase.
+ *
+ * Built against the TieredList when TEST_TIERED is defined, so that the
+ * sizes cross several changes of its block size, and against the
+ * ArrayDeque when TEST_DEQUE is defined.  The deque also gets addFirst,
+ * addLast, pollFirst and pollLast, which move its head around the buffer
+ * so that the gaps are opened and closed across the wrap, from either
+ * side, and the buffer grows while the deque wraps.
+ *
+ * Exits with status 1 if the list differs from the reference.
+ *
+ * usage: tieredtest [seed]
+ *        dequetest [seed]
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef TEST_TIERED
+#define LIST_IMPLEMENTATION tiered
+#include "collection/list/implementations/tieredlist.h"
+#define TEST_NAME "tiered list"
+#endif
+
+#ifdef TEST_DEQUE
+#define LIST_IMPLEMENTATION deque
+#include "collection/list/implementations/arraydeque.h"
+#define TEST_NAME "array deque"
+#endif
+
+#define SETTLE_OPERATIONS 2000 // per target, once it is reached
+#define MAX_BULK 300
+
+// sizes the list grows or shrinks to in turn
+static const int64_t targets[] = { 40, 700, 3000, 10000, 40000, 20, 5000, 0, 600 };
+
+static intptr_t* reference;
+static int64_t referenceSize;
+static int64_t referenceCapacity;
+static intptr_t nextValue = 1;
+static uint64_t operations;
+static uint64_t failures;
+
+static uint64_t nextRandom(uint64_t* state) {
+	// xorshift64*
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * UINT64_C(2685821657736338717);
+}
+
+static int64_t randomBelow(uint64_t* state, int64_t bound) {
+	return bound <= 0 ? 0 : (int64_t) (nextRandom(state) % (uint64_t) bound);
+}
+
+static void* value(intptr_t v) {
+	return (void*) v;
+}
+
+static void fail(const char* what, int64_t index) {
+	if (failures++ < 10)
+		fprintf(stderr, "%s at %ld after %lu operations\n", what, (long) index,
+				(unsigned long) operations);
+}
+
+/*
+ * Opens a gap of n elements at index of the reference.
+ */
+static void referenceInsert(int64_t index, int64_t n) {
+	if (referenceSize + n > referenceCapacity) {
+		referenceCapacity = (referenceSize + n) * 2;
+		reference = realloc(reference, sizeof(intptr_t) * referenceCapacity);
+		if (reference == NULL)
+			abort();
+	}
+	memmove(&reference[index + n], &reference[index], sizeof(intptr_t) * (referenceSize - index));
+	referenceSize += n;
+}
+
+static void referenceRemove(int64_t from, int64_t to) {
+	memmove(&reference[from], &reference[to], sizeof(intptr_t) * (referenceSize - to));
+	referenceSize -= to - from;
+}
+
+/*
+ * Compares list, whose elements are the reference from offset on, with
+ * the reference through get.
+ */
+static void checkElements(list_List list, int64_t offset, int64_t size) {
+	if (list_size(list) != size) {
+		fail("wrong size", list_size(list));
+		return;
+	}
+	for (int64_t i = 0; i < size; ++i)
+		if (list_get(list, i) != value(reference[offset + i])) {
+			fail("wrong element", i);
+			return;
+		}
+}
+
+/*
+ * Compares the whole list with the reference through nextSpan.
+ */
+static void checkSpans(list_List list) {
+	int64_t position = 0;
+	int64_t index = 0;
+	void* const* data;
+	size_t length;
+	while ((length = list_nextSpan(list, &position, &data)) > 0) {
+		for (size_t i = 0; i < length; ++i, ++index)
+			if (index >= referenceSize || data[i] != value(reference[index])) {
+				fail("wrong element in span", index);
+				return;
+			}
+		if (position != index) {
+			fail("wrong span position", position);
+			return;
+		}
+	}
+	if (index != referenceSize)
+		fail("spans end early", index);
+}
+
+#ifdef TEST_DEQUE
+/*
+ * Applies one random operation at an end of target, which holds the
+ * elements [offset, offset + size) of the reference, and mirrors it
+ * there.  Returns the new size of target.
+ */
+static int64_t applyDeque(uint64_t* state, list_List target, int64_t offset, int64_t size, bool grow) {
+	bool first = randomBelow(state, 2) == 0;
+	int64_t index = first ? 0 : size;
+	if (grow) {
+		if (first)
+			list_addFirst(target, value(nextValue));
+		else
+			list_addLast(target, value(nextValue));
+		referenceInsert(offset + index, 1);
+		reference[offset + index] = nextValue++;
+		return size + 1;
+	}
+	if (size == 0) {
+		if ((first ? list_pollFirst(target) : list_pollLast(target)) != NULL)
+			fail("poll of an empty deque returned an element", 0);
+		return size;
+	}
+	index = first ? 0 : size - 1;
+	void* peeked = first ? list_peekFirst(target) : list_peekLast(target);
+	if (peeked != value(reference[offset + index]))
+		fail("peek returned the wrong element", index);
+	if ((first ? list_pollFirst(target) : list_pollLast(target)) != peeked)
+		fail("poll returned the wrong element", index);
+	referenceRemove(offset + index, offset + index + 1);
+	return size - 1;
+}
+#endif
+
+/*
+ * Applies one random operation to target, which holds the elements
+ * [offset, offset + size) of the reference, and mirrors it there.  The
+ * operation grows the list when grow is set and shrinks it otherwise.
+ * Returns the new size of target.
+ */
+static int64_t applyRandom(uint64_t* state, list_List target, int64_t offset, int64_t size, bool grow) {
+	void* inserted[MAX_BULK];
+	int64_t bulk = 1 + randomBelow(state, randomBelow(state, 2) ? MAX_BULK : 4);
+	int64_t index;
+#ifdef TEST_DEQUE
+	if (randomBelow(state, 2) == 0)
+		return applyDeque(state, target, offset, size, grow);
+#endif
+	switch (randomBelow(state, 3) + (grow ? 0 : 3)) {
+	case 0: // addAt
+		index = randomBelow(state, size + 1);
+		list_addAt(target, index, value(nextValue));
+		referenceInsert(offset + index, 1);
+		reference[offset + index] = nextValue++;
+		return size + 1;
+	case 1: // addAllAt
+		index = randomBelow(state, size + 1);
+		for (int64_t i = 0; i < bulk; ++i)
+			inserted[i] = value(nextValue + i);
+		list_addAllAt(target, index, inserted, bulk);
+		referenceInsert(offset + index, bulk);
+		for (int64_t i = 0; i < bulk; ++i)
+			reference[offset + index + i] = nextValue++;
+		return size + bulk;
+	case 2: // set, which changes nothing structurally
+	case 5:
+		if (size > 0) {
+			index = randomBelow(state, size);
+			list_set(target, index, value(nextValue));
+			reference[offset + index] = nextValue++;
+		}
+		return size;
+	case 3: // removeAt
+		if (size == 0)
+			return size;
+		index = randomBelow(state, size);
+		if (list_removeAt(target, index) != value(reference[offset + index]))
+			fail("removeAt returned the wrong element", index);
+		referenceRemove(offset + index, offset + index + 1);
+		return size - 1;
+	default: { // removeRange
+		int64_t n = bulk < size ? bulk : size;
+		index = randomBelow(state, size - n + 1);
+		list_removeRange(target, index, index + n);
+		referenceRemove(offset + index, offset + index + n);
+		return size - n;
+	}
+	}
+}
+
+/*
+ * Applies one random operation to list or to a random view of it and
+ * checks the list or view that was changed.
+ */
+static void step(uint64_t* state, list_List list, bool grow) {
+	int64_t size = referenceSize;
+	++operations;
+	int depth = randomBelow(state, 4) == 0 ? 1 + randomBelow(state, 2) : 0;
+	if (depth == 0) {
+		size = applyRandom(state, list, 0, size, grow);
+		if (size < 64 || randomBelow(state, 16) == 0)
+			checkElements(list, 0, size);
+		return;
+	}
+	int64_t from = randomBelow(state, size + 1);
+	int64_t to = from + randomBelow(state, size - from + 1);
+	list_List outer = list_subList(list, from, to);
+	int64_t offset = from;
+	size = to - from;
+	list_List inner = NULL;
+	if (depth == 2) {
+		int64_t innerFrom = randomBelow(state, size + 1);
+		int64_t innerTo = innerFrom + randomBelow(state, size - innerFrom + 1);
+		inner = list_subList(outer, innerFrom, innerTo);
+		offset += innerFrom;
+		size = innerTo - innerFrom;
+	}
+	int64_t outerSize = list_size(outer);
+	int64_t newSize = applyRandom(state, inner != NULL ? inner : outer, offset, size, grow);
+	if (inner != NULL) {
+		checkElements(inner, offset, newSize);
+		list_delList(inner);
+	}
+	checkElements(outer, from, outerSize + newSize - size);
+	list_delList(outer);
+}
+
+int main(int argc, char* argv[]) {
+	uint64_t state = argc > 1 ? strtoull(argv[1], NULL, 0) : 0x9e3779b97f4a7c15u;
+	if (state == 0)
+		state = 1;
+	list_List list = list_newList();
+	for (size_t t = 0; t < sizeof(targets) / sizeof(targets[0]); ++t) {
+		int64_t target = targets[t];
+		bool grow = referenceSize < target;
+		// step until the target is crossed, then a while around it
+		for (int64_t settle = 0; settle < SETTLE_OPERATIONS; ) {
+			step(&state, list, referenceSize < target);
+			if (grow == (referenceSize >= target) || referenceSize == target)
+				++settle;
+		}
+		checkElements(list, 0, referenceSize);
+		checkSpans(list);
+#ifdef TEST_TIERED
+		fprintf(stderr, "%8ld elements, block size %ld\n", (long) referenceSize,
+				(long) list_blockSize(list));
+#endif
+	}
+	list_delList(list);
+	free(reference);
+	fprintf(stderr, TEST_NAME " %s (%lu operations)\n",
+			failures == 0 ? "ok" : "FAILED", (unsigned long) operations);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Checks every pointer search kernel of the ArrayList that this CPU
+ * supports against the scalar kernel.  Arrays of every size up to
+ * MAX_SIZE, starting at every offset within a vector, are searched for
+ * a pointer found in each slot, in two slots, nowhere, and for NULL, so
+ * that the head, the vector body and the remainder of every kernel are
+ * covered; random arrays with many duplicates follow.
+ *
+ * Prints one line per kernel on stderr and exits with status 1 if any
+ * kernel disagrees with the scalar one.
+ *
+ * usage: searchtest
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define LIST_IMPLEMENTATION array
+#include "collection/list/implementations/arraylist.h"
+
+#define MAX_SIZE 80 // several vector bodies of the widest kernel
+#define MAX_OFFSET 8 // slots in the widest vector
+#define RANDOM_ARRAYS 20000
+#define RANDOM_MAX_SIZE 1000
+
+static const list_SearchKernels* reference;
+static uint64_t checks;
+static uint64_t failures;
+
+static uint64_t nextRandom(uint64_t* state) {
+	// xorshift64*
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * UINT64_C(2685821657736338717);
+}
+
+static void* value(uintptr_t v) {
+	return (void*) (v + 1);
+}
+
+/*
+ * Searches array[0, size) for o with both functions of kernel and compares
+ * the results with the scalar kernel.
+ */
+static void check(const list_SearchKernels* kernel, void** array, int64_t size, void* o) {
+	int64_t expected = reference->indexOf(array, size, o);
+	int64_t actual = kernel->indexOf(array, size, o);
+	if (actual != expected && failures++ < 10)
+		fprintf(stderr, "%s indexOf(size %ld, %p): %ld instead of %ld\n",
+				kernel->name, (long) size, o, (long) actual, (long) expected);
+	expected = reference->lastIndexOf(array, size, o);
+	actual = kernel->lastIndexOf(array, size, o);
+	if (actual != expected && failures++ < 10)
+		fprintf(stderr, "%s lastIndexOf(size %ld, %p): %ld instead of %ld\n",
+				kernel->name, (long) size, o, (long) actual, (long) expected);
+	checks += 2;
+}
+
+static void checkSizes(const list_SearchKernels* kernel) {
+	void* buffer[MAX_OFFSET + MAX_SIZE];
+	void* key = value(MAX_SIZE);
+	for (int offset = 0; offset < MAX_OFFSET; ++offset) {
+		void** array = buffer + offset;
+		for (int64_t size = 0; size <= MAX_SIZE; ++size) {
+			for (int64_t i = 0; i < size; ++i)
+				array[i] = value(i);
+			check(kernel, array, size, key);
+			check(kernel, array, size, NULL);
+			for (int64_t i = 0; i < size; ++i) {
+				check(kernel, array, size, array[i]);
+				array[i] = NULL;
+				check(kernel, array, size, NULL);
+				array[i] = key;
+				for (int64_t j = i + 1; j < size; ++j) {
+					array[j] = key;
+					check(kernel, array, size, key);
+					array[j] = value(j);
+				}
+				array[i] = value(i);
+			}
+		}
+	}
+}
+
+static void checkRandom(const list_SearchKernels* kernel) {
+	static void* buffer[MAX_OFFSET + RANDOM_MAX_SIZE];
+	uint64_t state = 0x9e3779b97f4a7c15u;
+	for (int n = 0; n < RANDOM_ARRAYS; ++n) {
+		void** array = buffer + nextRandom(&state) % MAX_OFFSET;
+		int64_t size = nextRandom(&state) % (RANDOM_MAX_SIZE + 1);
+		// few distinct values, some of them NULL, so most keys occur many times
+		uintptr_t distinct = nextRandom(&state) % 64 + 1;
+		for (int64_t i = 0; i < size; ++i) {
+			uintptr_t v = nextRandom(&state) % (distinct * 4);
+			array[i] = v < distinct ? NULL : value(v % distinct);
+		}
+		for (uintptr_t v = 0; v <= distinct; ++v)
+			check(kernel, array, size, value(v));
+		check(kernel, array, size, NULL);
+	}
+}
+
+int main(int argc, char* argv[]) {
+	size_t count;
+	const list_SearchKernels* kernels = list_searchKernels(&count);
+	reference = &kernels[0];
+	for (size_t k = 1; k < count; ++k) {
+		uint64_t failuresBefore = failures;
+		checks = 0;
+		checkSizes(&kernels[k]);
+		checkRandom(&kernels[k]);
+		fprintf(stderr, "%-8s %s (%lu checks)\n", kernels[k].name,
+				failures == failuresBefore ? "ok" : "FAILED", (unsigned long) checks);
+	}
+	if (count == 1)
+		fprintf(stderr, "only the scalar kernel is built for this CPU\n");
+	return failures == 0 ? 0 : 1;
+}
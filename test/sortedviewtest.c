@@ -0,0 +1,173 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Checks that a view of a sorted ArrayList stops using its comparator once
+ * the order of its elements may have changed through another list: after
+ * set on the root, on another view or inline, and after sort on the root
+ * or on an enclosing view.  The searches of the view must then find
+ * every element again.
+ *
+ * Exits with status 1 if a search misses.
+ *
+ * usage: sortedviewtest
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+// list_set is the inline accessor, which skips the library for roots
+// that are not known to be sorted
+#define ARRAYLIST_INLINE
+#define LIST_IMPLEMENTATION array
+#include "collection/list/implementations/arraylist.h"
+
+#define SIZE 8
+
+static uint64_t checks;
+static uint64_t failures;
+
+static void* value(intptr_t v) {
+	return (void*) v;
+}
+
+static int ascending(const void* a, const void* b) {
+	return (intptr_t) a < (intptr_t) b ? -1 : (intptr_t) a > (intptr_t) b;
+}
+
+static int descending(const void* a, const void* b) {
+	return ascending(b, a);
+}
+
+static void check(bool passed, const char* what) {
+	++checks;
+	if (!passed && failures++ < 10)
+		fprintf(stderr, "failed: %s\n", what);
+}
+
+/*
+ * Checks that every search of list finds the element at each index.
+ */
+static void checkSearches(list_List list, const char* what) {
+	for (int64_t i = 0; i < list_size(list); ++i) {
+		void* e = list_get(list, i);
+		check(list_contains(list, e), what);
+		check(list_indexOf(list, e) == i, what);
+		check(list_lastIndexOf(list, e) == i, what);
+	}
+}
+
+// a root holding 1..SIZE in ascending order, not known to be sorted
+static list_List newRoot() {
+	list_List list = list_newList();
+	for (intptr_t i = 1; i <= SIZE; ++i)
+		list_add(list, value(i));
+	return list;
+}
+
+static void checkSetOnRoot() {
+	list_List list = newRoot();
+	list_sort(list, ascending);
+	list_List view = list_subList(list, 0, SIZE);
+	check(list_comparator(view) == ascending, "view inherits the comparator");
+	list_set(list, 0, value(100));
+	check(list_comparator(view) == NULL, "set on the root clears the comparator of a view");
+	check(list_contains(view, value(100)), "view finds an element set on the root");
+	checkSearches(view, "view searches after set on the root");
+	list_delList(view);
+	list_delList(list);
+}
+
+static void checkSetOnOtherView() {
+	list_List list = newRoot();
+	list_sort(list, ascending);
+	list_List left = list_subList(list, 0, SIZE / 2);
+	list_List right = list_subList(list, SIZE / 2, SIZE);
+	list_List middle = list_subList(list, 2, SIZE);
+	list_set(right, 0, value(0));
+	check(list_comparator(middle) == NULL, "set on a view clears the comparator of another view");
+	check(list_contains(middle, value(0)), "view finds an element set on another view");
+	checkSearches(middle, "view searches after set on another view");
+	checkSearches(left, "disjoint view searches after set on another view");
+	checkSearches(list, "root searches after set on a view");
+	list_delList(middle);
+	list_delList(right);
+	list_delList(left);
+	list_delList(list);
+}
+
+static void checkInlineSet() {
+	list_List list = newRoot();
+	list_List view = list_subList(list, 0, SIZE);
+	list_assumeSorted(view, ascending);
+	list_set(list, 0, value(100));
+	check(list_comparator(view) == NULL, "inline set on the root clears the comparator of a view");
+	check(list_contains(view, value(100)), "view finds an element set inline on the root");
+	checkSearches(view, "view searches after inline set on the root");
+	list_delList(view);
+	list_delList(list);
+}
+
+static void checkSortOnRoot() {
+	list_List list = newRoot();
+	list_sort(list, ascending);
+	list_sort(list, descending);
+	list_List view = list_subList(list, 0, SIZE);
+	check(list_comparator(view) == descending, "view of a re-sorted root has its comparator");
+	check(list_indexOf(view, value(2)) == list_indexOf(list, value(2)), "view agrees with the re-sorted root");
+	checkSearches(view, "view searches after sort on the root");
+	list_delList(view);
+	list_delList(list);
+}
+
+static void checkSortOnView() {
+	list_List list = newRoot();
+	list_sort(list, ascending);
+	list_List outer = list_subList(list, 0, SIZE);
+	list_List inner = list_subList(outer, 0, SIZE);
+	list_sort(inner, descending);
+	check(list_comparator(inner) == descending, "sorted view keeps its comparator");
+	check(list_comparator(outer) == NULL, "sort on a view clears the comparator of the enclosing view");
+	check(list_comparator(list) == NULL, "sort on a view clears the comparator of the root");
+	checkSearches(inner, "view searches after its sort");
+	checkSearches(outer, "enclosing view searches after sort on a view");
+	checkSearches(list, "root searches after sort on a view");
+	list_delList(inner);
+	list_delList(outer);
+	list_delList(list);
+}
+
+int main(int argc, char* argv[]) {
+	checkSetOnRoot();
+	checkSetOnOtherView();
+	checkInlineSet();
+	checkSortOnRoot();
+	checkSortOnView();
+	fprintf(stderr, "sorted views %s (%lu checks)\n",
+			failures == 0 ? "ok" : "FAILED", (unsigned long) checks);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright 1997-2007 Sun Microsystems, Inc.  All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Sun designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Sun in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Sun Microsystems, Inc., 4150 Network Circle, Santa Clara,
+ * CA 95054 USA or visit www.sun.com if you need additional information or
+ * have any questions.
+ */
+
+/*
+ * Stress test of the SynchronizedList.  One thread modifies the list while
+ * the others read it.  The list always holds a run of consecutive elements
+ * of values, which the writer grows and shrinks at both ends, so every
+ * operation that moves elements or replaces the array is exercised.  The
+ * readers check that every snapshot they see is such a run; the writer
+ * checks the final contents.  Build it with -fsanitize=thread (see the
+ * synclisttsan target) to check that readers and writer do not race.
+ *
+ * Prints the number of reads on stderr and exits with status 1 if a
+ * reader or the writer saw an inconsistent list.
+ *
+ * usage: synclisttest
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#define LIST_IMPLEMENTATION synchronized
+#include "collection/list/implementations/synchronizedlist.h"
+
+#define VALUES 65536
+#define MAX_RUN 64 // elements added by one addAll
+#define WRITES 200000
+#define READERS 3
+
+static int64_t values[VALUES];
+static list_List list;
+static _Atomic bool stop;
+static _Atomic uint64_t failures;
+
+static uint64_t nextRandom(uint64_t* state) {
+	// xorshift64*
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * UINT64_C(2685821657736338717);
+}
+
+static void fail(const char* message, long index) {
+	if (failures++ < 10)
+		fprintf(stderr, "%s (%ld)\n", message, index);
+}
+
+/*
+ * Checks that each element follows the one before it in values.
+ */
+static bool checkNext(void* element, void* context) {
+	int64_t** previous = context;
+	if (element < (void*) values || element >= (void*) (values + VALUES))
+		fail("forEach saw an element not in values", -1);
+	else if (*previous != NULL && element != *previous + 1)
+		fail("forEach saw a run with a gap", (int64_t*) element - values);
+	*previous = element;
+	return true;
+}
+
+static void* reader(void* argument) {
+	uint64_t state = (uintptr_t) argument * 0x9e3779b97f4a7c15u + 1;
+	uint64_t reads = 0;
+	while (!stop) {
+		int64_t* previous = NULL;
+		list_forEach(list, checkNext, &previous);
+		// the run starts at or before the searched element, if it holds it
+		int64_t i = nextRandom(&state) % VALUES;
+		int64_t index = list_indexOf(list, &values[i]);
+		if (index < -1 || index > i)
+			fail("indexOf out of range", index);
+		index = list_lastIndexOf(list, &values[i]);
+		if (index < -1 || index > i)
+			fail("lastIndexOf out of range", index);
+		int64_t size = list_size(list);
+		if (size < 0 || size > VALUES)
+			fail("size out of range", size);
+		reads += 4;
+	}
+	return (void*) (uintptr_t) reads;
+}
+
+/*
+ * Applies random operations that keep list equal to values[first, first + size).
+ */
+static void modify(int64_t* first, int64_t* size) {
+	uint64_t state = 0x2545f4914f6cdd1du;
+	void* run[MAX_RUN];
+	for (int n = 0; n < WRITES; ++n) {
+		int64_t count = nextRandom(&state) % MAX_RUN + 1;
+		switch (nextRandom(&state) % 8) {
+		case 0:
+			if (*first + *size < VALUES)
+				list_add(list, &values[*first + (*size)++]);
+			break;
+		case 1:
+			if (*first > 0) {
+				list_addAt(list, 0, &values[--*first]);
+				++*size;
+			}
+			break;
+		case 2:
+			if (*size > 0) {
+				list_removeAt(list, 0);
+				++*first;
+				--*size;
+			}
+			break;
+		case 3:
+			if (*size > 0)
+				list_removeAt(list, --*size);
+			break;
+		case 4:
+			if (*first + *size + count <= VALUES) {
+				for (int64_t i = 0; i < count; ++i)
+					run[i] = &values[*first + *size + i];
+				list_addAll(list, run, count);
+				*size += count;
+			}
+			break;
+		case 5:
+			if (*first >= count) {
+				for (int64_t i = 0; i < count; ++i)
+					run[i] = &values[*first - count + i];
+				list_addAllAt(list, 0, run, count);
+				*first -= count;
+				*size += count;
+			}
+			break;
+		case 6:
+			if (*size > 0) {
+				int64_t i = nextRandom(&state) % *size;
+				list_set(list, i, &values[*first + i]);
+			}
+			break;
+		default:
+			if (nextRandom(&state) % 256 == 0) {
+				list_clear(list);
+				*first = VALUES / 2;
+				*size = 0;
+			}
+			break;
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	list = list_newList();
+	pthread_t readers[READERS];
+	for (uintptr_t r = 0; r < READERS; ++r)
+		pthread_create(&readers[r], NULL, reader, (void*) r);
+	int64_t first = VALUES / 2;
+	int64_t size = 0;
+	modify(&first, &size);
+	stop = true;
+	uint64_t reads = 0;
+	for (int r = 0; r < READERS; ++r) {
+		void* result;
+		pthread_join(readers[r], &result);
+		reads += (uintptr_t) result;
+	}
+	if (list_size(list) != size)
+		fail("final size is wrong", list_size(list));
+	else
+		for (int64_t i = 0; i < size; ++i)
+			if (list_get(list, i) != &values[first + i])
+				fail("final element is wrong", i);
+	list_delList(list);
+	fprintf(stderr, "synchronized list %s (%lu reads)\n",
+			failures == 0 ? "ok" : "FAILED", (unsigned long) reads);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+ifeq ($(BASE_DIR),)
+abort:   ## This MUST be the first target :( ugly
+	@echo Make must be run from the root of the project && false
+endif
+
+CURRENT_DIR:=$(CURRENT_DIR)/test
+
+# The library sources are compiled into each test with -DCOLLECTION_TEST,
+# which builds the hooks that expose internals such as the search kernels.
+TEST_ARRAY_SRC:= $(BASE_DIR)/src/collection/allocator.c \
+	$(BASE_DIR)/src/collection/list/implementations/arraylist.c
+TEST_SYNC_LIST_SRC:= $(BASE_DIR)/src/collection/allocator.c \
+	$(BASE_DIR)/src/collection/epoch.c \
+	$(BASE_DIR)/src/collection/list/implementations/synchronizedlist.c \
+	$(BASE_DIR)/src/collection/list/implementations/syncarraylist.c
+TEST_TIERED_SRC:= $(BASE_DIR)/src/collection/allocator.c \
+	$(BASE_DIR)/src/collection/list/implementations/tieredlist.c
+TEST_DEQUE_SRC:= $(BASE_DIR)/src/collection/allocator.c \
+	$(BASE_DIR)/src/collection/list/implementations/arraydeque.c
+TEST_CFLAGS:= -O2 -Wall -DCOLLECTION_TEST -I$(BASE_DIR)/include
+TEST_DIR:= $(if $(filter /%,$(BUILD_DIR)),$(BUILD_DIR),$(BASE_DIR)/$(BUILD_DIR))
+
+all: run
+
+searchtest: searchtest.c $(TEST_ARRAY_SRC)
+	gcc $(TEST_CFLAGS) -o $(TEST_DIR)/searchtest \
+		searchtest.c $(TEST_ARRAY_SRC) -lpthread
+
+blockmovetest: blockmovetest.c $(TEST_ARRAY_SRC)
+	gcc $(TEST_CFLAGS) -o $(TEST_DIR)/blockmovetest \
+		blockmovetest.c $(TEST_ARRAY_SRC) -lpthread
+
+tieredtest: listtest.c $(TEST_TIERED_SRC)
+	gcc $(TEST_CFLAGS) -DTEST_TIERED -o $(TEST_DIR)/tieredtest \
+		listtest.c $(TEST_TIERED_SRC)
+
+dequetest: listtest.c $(TEST_DEQUE_SRC)
+	gcc $(TEST_CFLAGS) -DTEST_DEQUE -o $(TEST_DIR)/dequetest \
+		listtest.c $(TEST_DEQUE_SRC)
+
+sortedviewtest: sortedviewtest.c $(TEST_ARRAY_SRC)
+	gcc $(TEST_CFLAGS) -o $(TEST_DIR)/sortedviewtest \
+		sortedviewtest.c $(TEST_ARRAY_SRC) -lpthread
+
+synclisttest: synclisttest.c $(TEST_SYNC_LIST_SRC)
+	gcc $(TEST_CFLAGS) -o $(TEST_DIR)/synclisttest \
+		synclisttest.c $(TEST_SYNC_LIST_SRC) -lpthread
+
+# the same test under ThreadSanitizer, which reports any data race between
+# the readers and the writer of the synchronized list; it does not model the
+# fences of the sequence lock, which only order accesses that are atomic
+synclisttsan: synclisttest.c $(TEST_SYNC_LIST_SRC)
+	gcc $(TEST_CFLAGS) -g -fsanitize=thread -Wno-tsan -o $(TEST_DIR)/synclisttsan \
+		synclisttest.c $(TEST_SYNC_LIST_SRC) -lpthread
+	$(TEST_DIR)/synclisttsan
+
+run: searchtest blockmovetest tieredtest dequetest sortedviewtest synclisttest
+	$(TEST_DIR)/searchtest
+	$(TEST_DIR)/blockmovetest
+	$(TEST_DIR)/tieredtest
+	$(TEST_DIR)/dequetest
+	$(TEST_DIR)/sortedviewtest
+	$(TEST_DIR)/synclisttest